@@ -3,6 +3,13 @@
 #include "../Logger/Logger.h"
 #include <SDL_image.h>
 #include <cassert>
+#include <algorithm>
+
+// Textures up to this size on both sides are packed into atlas pages.
+const int AtlasMaxPackedSize = 256;
+const int AtlasPageSize = 2048;
+// Empty pixels between packed textures, keeps filtering from bleeding into neighbours.
+const int AtlasPadding = 1;
 
 AssetStore::AssetStore()
 {
@@ -23,6 +30,17 @@ void AssetStore::ClearAssets()
 		SDL_DestroyTexture(texture.second);
 	}
 	textures.clear();
+	textureRegions.clear();
+
+	for (SDL_Texture* atlasPage : atlasPages) {
+		SDL_DestroyTexture(atlasPage);
+	}
+	atlasPages.clear();
+
+	for (auto candidate : atlasCandidates) {
+		SDL_FreeSurface(candidate.second);
+	}
+	atlasCandidates.clear();
 
 	// Clear fonts
 
@@ -35,19 +53,136 @@ void AssetStore::ClearAssets()
 void AssetStore::AddTexture(SDL_Renderer& renderer, const std::string& assetId, const std::string& filePath)
 {
 	SDL_Surface* surface = IMG_Load(filePath.c_str());
+	if (!surface) {
+		Logger::Err("Could not load the texture: " + filePath);
+		return;
+	}
+
 	SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
-	
-	SDL_FreeSurface(surface);
 
-	textures.emplace(assetId, texture);
+	if (!textures.emplace(assetId, texture).second) {
+		SDL_DestroyTexture(texture);
+		SDL_FreeSurface(surface);
+		return;
+	}
+
+	textureRegions.emplace(assetId, TextureRegion{ texture, { 0, 0, surface->w, surface->h } });
+
+	if (surface->w <= AtlasMaxPackedSize && surface->h <= AtlasMaxPackedSize) {
+		atlasCandidates.emplace(assetId, surface);
+	}
+	else {
+		SDL_FreeSurface(surface);
+	}
 }
 
+/**
+ * @brief Whole texture of the asset, not the atlas page. Use it for tilesets and UI that need the full image.
+ */
 SDL_Texture* AssetStore::GetTexture(const std::string& assetId) const
 {
 	assert(textures.find(assetId) != textures.end());
 	return textures.at(assetId);
 }
 
+const TextureRegion& AssetStore::GetTextureRegion(const std::string& assetId) const
+{
+	assert(textureRegions.find(assetId) != textureRegions.end());
+	return textureRegions.at(assetId);
+}
+
+/**
+ * @brief Packs the small textures added since the last call into shared atlas pages.
+ *
+ * Uses shelf packing, tallest textures first. The regions of the packed assets
+ * point into the pages afterwards, their own textures stay valid for GetTexture.
+ */
+void AssetStore::BuildAtlases(SDL_Renderer& renderer)
+{
+	if (atlasCandidates.size() < 2) {
+		for (auto candidate : atlasCandidates) {
+			SDL_FreeSurface(candidate.second);
+		}
+		atlasCandidates.clear();
+		return;
+	}
+
+	struct PackedTexture
+	{
+		const std::string* assetId;
+		SDL_Surface* surface;
+		SDL_Rect rect;
+		size_t pageIndex;
+	};
+
+	std::vector<PackedTexture> packedTextures;
+	packedTextures.reserve(atlasCandidates.size());
+	for (const auto& candidate : atlasCandidates) {
+		packedTextures.push_back({ &candidate.first, candidate.second, { 0, 0, candidate.second->w, candidate.second->h }, 0 });
+	}
+
+	// Stable, so equal heights keep the asset id order and the layout does not change between runs.
+	std::stable_sort(packedTextures.begin(), packedTextures.end(), [](const PackedTexture& a, const PackedTexture& b) {
+		return a.rect.h > b.rect.h;
+	});
+
+	std::vector<SDL_Point> pageSizes(1, SDL_Point{ 0, 0 });
+	int shelfX = 0;
+	int shelfY = 0;
+	int shelfHeight = 0;
+
+	for (PackedTexture& packedTexture : packedTextures) {
+		if (shelfX + packedTexture.rect.w > AtlasPageSize) {
+			shelfX = 0;
+			shelfY += shelfHeight + AtlasPadding;
+			shelfHeight = 0;
+		}
+
+		if (shelfY + packedTexture.rect.h > AtlasPageSize) {
+			pageSizes.push_back(SDL_Point{ 0, 0 });
+			shelfX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+
+		packedTexture.rect.x = shelfX;
+		packedTexture.rect.y = shelfY;
+		packedTexture.pageIndex = pageSizes.size() - 1;
+
+		SDL_Point& pageSize = pageSizes.back();
+		pageSize.x = std::max(pageSize.x, shelfX + packedTexture.rect.w);
+		pageSize.y = std::max(pageSize.y, shelfY + packedTexture.rect.h);
+
+		shelfX += packedTexture.rect.w + AtlasPadding;
+		shelfHeight = std::max(shelfHeight, packedTexture.rect.h);
+	}
+
+	std::vector<SDL_Surface*> pageSurfaces;
+	for (const SDL_Point& pageSize : pageSizes) {
+		pageSurfaces.push_back(SDL_CreateRGBSurfaceWithFormat(0, pageSize.x, pageSize.y, 32, SDL_PIXELFORMAT_RGBA32));
+	}
+
+	for (PackedTexture& packedTexture : packedTextures) {
+		// Copy the pixels as they are, including alpha.
+		SDL_SetSurfaceBlendMode(packedTexture.surface, SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(packedTexture.surface, nullptr, pageSurfaces[packedTexture.pageIndex], &packedTexture.rect);
+	}
+
+	const size_t firstPageIndex = atlasPages.size();
+	for (SDL_Surface* pageSurface : pageSurfaces) {
+		atlasPages.push_back(SDL_CreateTextureFromSurface(&renderer, pageSurface));
+		SDL_FreeSurface(pageSurface);
+	}
+
+	for (const PackedTexture& packedTexture : packedTextures) {
+		textureRegions[*packedTexture.assetId] = TextureRegion{ atlasPages[firstPageIndex + packedTexture.pageIndex], packedTexture.rect };
+		SDL_FreeSurface(packedTexture.surface);
+	}
+
+	Logger::Log("Packed " + std::to_string(packedTextures.size()) + " textures into " + std::to_string(pageSurfaces.size()) + " atlas pages");
+	atlasCandidates.clear();
+}
+
 void AssetStore::AddFont(const std::string& assetId, const std::string& filePath, int fontSize)
 {
 	fonts.emplace(assetId, TTF_OpenFont(filePath.c_str(), fontSize));
@@ -1,10 +1,20 @@
 #pragma once
 
 #include <map>
+#include <vector>
 #include <string>
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+/**
+ * @brief Area of a texture asset, either a whole texture or a part of an atlas page.
+ */
+struct TextureRegion
+{
+	SDL_Texture* texture;
+	SDL_Rect rect;
+};
+
 class AssetStore
 {
 public:
@@ -15,13 +25,26 @@ public:
 	void AddTexture(SDL_Renderer& renderer, const std::string& assetId, const std::string& filePath);
 	SDL_Texture* GetTexture(const std::string& assetId) const;
 
+	/**
+	 * @brief Where to sample the asset from. Sprites should draw through this, so packed textures
+	 * share their atlas page. Offset source rects by the rect position.
+	 */
+	const TextureRegion& GetTextureRegion(const std::string& assetId) const;
+
+	void BuildAtlases(SDL_Renderer& renderer);
+
 	void AddFont(const std::string& assetId, const std::string& filePath, int fontSize);
 	TTF_Font* GetFont(const std::string& assetId) const;
 
 private:
 	std::map<std::string, SDL_Texture*> textures;
+	std::map<std::string, TextureRegion> textureRegions;
 	std::map<std::string, TTF_Font*> fonts;
 
+	// Pixels of the small textures added since the last BuildAtlases.
+	std::map<std::string, SDL_Surface*> atlasCandidates;
+	std::vector<SDL_Texture*> atlasPages;
+
 	// TODO: map for audio
 
 };
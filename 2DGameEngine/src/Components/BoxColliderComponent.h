@@ -1,24 +1,57 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
+
+using CollisionMask = uint32_t;
+
+const CollisionMask COLLISION_MASK_ALL = ~CollisionMask(0);
+
+enum class CollisionLayer
+{
+	LAYER_default,
+	LAYER_player,
+	LAYER_enemy,
+	LAYER_projectile,
+	LAYER_obstacle,
+	LAYER_tile,
+	LAYER_count
+};
+
+enum class ColliderShape
+{
+	SHAPE_box,
+	SHAPE_circle
+};
 
 /**
  * @brief Component that stores collision box parameters.
- * 
- * Currently entity scale is not reflected on the collider automatically,
- * it needs to be done manually.
- * TODO: Find a way to set it easily.
+ *
+ * Width, height and offset are in sprite units, the scale and rotation of the
+ * transform are applied to them by the collision system. Boxes of rotated
+ * entities become oriented boxes, circle shapes fit into the box.
+ *
+ * The layer selects the row of the collision matrix the collider uses,
+ * the mask can further restrict which layers it collides with.
  */
 struct BoxColliderComponent
 {
-	BoxColliderComponent(const int width = 0, const int height = 0, const glm::vec2 offset = glm::vec2(0))
+	BoxColliderComponent(const int width = 0, const int height = 0, const glm::vec2 offset = glm::vec2(0),
+						 const CollisionLayer layer = CollisionLayer::LAYER_default, const CollisionMask mask = COLLISION_MASK_ALL,
+						 const ColliderShape shape = ColliderShape::SHAPE_box)
 		: width(width)
 		, height(height)
 		, offset(offset)
+		, layer(layer)
+		, mask(mask)
+		, shape(shape)
 	{
 	}
 
 	int width;
 	int height;
 	glm::vec2 offset;
+	CollisionLayer layer;
+	CollisionMask mask;
+	ColliderShape shape;
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SDL.h>
+#include <glm/glm.hpp>
+#include <string>
+
+/**
+ * @brief Spawns particles around the entity, continuously at emitRate and once as a burst of burstCount.
+ *
+ * Directions are in degrees, 0 along +x and clockwise on screen; spreadDeg is the
+ * full width of the cone, 360 for all directions. Particles shrink and fade from
+ * the start to the end values over their lifetime. Without an assetId they are
+ * drawn as plain colored squares.
+ */
+struct ParticleEmitterComponent
+{
+	ParticleEmitterComponent(const std::string& assetId = "", const float emitRate = 0.0f, const unsigned burstCount = 0,
+							 const float minLifetimeS = 0.5f, const float maxLifetimeS = 1.0f, const float minSpeed = 20.0f, const float maxSpeed = 60.0f,
+							 const float directionDeg = 0.0f, const float spreadDeg = 360.0f, const glm::vec2 acceleration = glm::vec2(0),
+							 const float startSize = 4.0f, const float endSize = 0.0f,
+							 const SDL_Color startColor = { 255, 255, 255, 255 }, const SDL_Color endColor = { 255, 255, 255, 0 })
+		: assetId(assetId)
+		, emitRate(emitRate)
+		, burstCount(burstCount)
+		, minLifetimeS(minLifetimeS)
+		, maxLifetimeS(maxLifetimeS)
+		, minSpeed(minSpeed)
+		, maxSpeed(maxSpeed)
+		, directionDeg(directionDeg)
+		, spreadDeg(spreadDeg)
+		, acceleration(acceleration)
+		, startSize(startSize)
+		, endSize(endSize)
+		, startColor(startColor)
+		, endColor(endColor)
+		, isEmitting(true)
+		, emitAccumulator(0.0f)
+	{
+	}
+
+	std::string assetId;
+
+	// Particles per second while isEmitting.
+	float emitRate;
+
+	// Spawned at once on the next update, then reset to 0.
+	unsigned burstCount;
+
+	float minLifetimeS;
+	float maxLifetimeS;
+	float minSpeed;
+	float maxSpeed;
+	float directionDeg;
+	float spreadDeg;
+	glm::vec2 acceleration;
+
+	float startSize;
+	float endSize;
+	SDL_Color startColor;
+	SDL_Color endColor;
+
+	bool isEmitting;
+
+	// Fraction of a particle carried over to the next update.
+	float emitAccumulator;
+};
@@ -4,10 +4,18 @@
 
 struct RigidBodyComponent
 {
-	RigidBodyComponent(const glm::vec2 velocity = glm::vec2(0.0f, 0.0f))
+	RigidBodyComponent(const glm::vec2 velocity = glm::vec2(0.0f, 0.0f), const bool continuousCollision = false)
 		: velocity(velocity)
+		, lastDisplacement(0.0f)
+		, continuousCollision(continuousCollision)
 	{
 	}
 
 	glm::vec2 velocity;
+
+	// Movement applied in the last update, used to sweep fast bodies.
+	glm::vec2 lastDisplacement;
+
+	// Fast bodies are swept along their movement so they cannot tunnel through thin colliders.
+	bool continuousCollision;
 };
@@ -6,12 +6,17 @@ struct TransformComponent
 {
 	TransformComponent(glm::vec2 position = glm::vec2(0.0f, 0.0f), glm::vec2 scale= glm::vec2(1.0f, 1.0f), const float rotation = 0.0)
 		: position(position)
+		, previousPosition(position)
 		, scale(scale)
 		, rotation(rotation)
 	{
 	}
 
 	glm::vec2 position;
+
+	// Position before the last simulation tick, drawing interpolates from it to position.
+	glm::vec2 previousPosition;
+
 	glm::vec2 scale;
 	double rotation;
 };
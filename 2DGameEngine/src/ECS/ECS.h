@@ -90,10 +90,11 @@ class System
 
 public:
 	System() = default;
-	~System() = default;
+	virtual ~System() = default;
 
-	void AddEntityToSystem(const Entity entity);
-	void RemoveEntityFromSystem(const Entity entity);
+	// Systems that keep their own data per entity can override these to stay in sync.
+	virtual void AddEntityToSystem(const Entity entity);
+	virtual void RemoveEntityFromSystem(const Entity entity);
 	std::vector<Entity>& GetSystemEntities();
 	Signature GetComponentSignature() const;
 
@@ -54,6 +54,9 @@ public:
 	template <typename TEvent, typename ...TArgs>
 	void EmitEvents(TArgs&& ...args);
 
+	template <typename TEvent>
+	bool HasSubscribers() const;
+
 private:
 	std::map<std::type_index, std::unique_ptr<HandlerList>> subscribers;
 
@@ -94,6 +97,16 @@ inline void EventBus::EmitEvents(TArgs&& ...args)
 	}
 }
 
+/**
+ * @brief Lets emitters skip building events nobody listens to.
+ */
+template<typename TEvent>
+inline bool EventBus::HasSubscribers() const
+{
+	auto subscribersIt = subscribers.find(typeid(TEvent));
+	return (subscribersIt != subscribers.end()) && subscribersIt->second && !subscribersIt->second->empty();
+}
+
 template<typename TEvent>
 inline void EventCallback<TEvent>::Call(Event& e)
 {
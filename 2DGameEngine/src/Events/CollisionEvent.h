@@ -3,6 +3,16 @@
 #include "../ECS/ECS.h"
 #include "../EventBus/Event.h"
 
+#include <vector>
+
+struct CollisionPair
+{
+	CollisionPair(Entity a, Entity b) : a(a), b(b) {}
+
+	Entity a;
+	Entity b;
+};
+
 class CollisionEvent : public Event
 {
 public:
@@ -13,6 +23,49 @@ public:
 	Entity b;
 };
 
+// Emitted on the first update two colliders overlap.
+class CollisionEnterEvent : public CollisionEvent
+{
+public:
+	CollisionEnterEvent(Entity a, Entity b) : CollisionEvent(a, b) {}
+};
+
+// Emitted on every following update while the colliders keep overlapping.
+class CollisionStayEvent : public CollisionEvent
+{
+public:
+	CollisionStayEvent(Entity a, Entity b) : CollisionEvent(a, b) {}
+};
+
+// Emitted once the colliders stop overlapping. Not emitted when one of them is destroyed.
+class CollisionExitEvent : public CollisionEvent
+{
+public:
+	CollisionExitEvent(Entity a, Entity b) : CollisionEvent(a, b) {}
+};
+
+/**
+ * @brief All contact changes of one collision update, emitted once per update.
+ *
+ * Cheaper than the per pair events when there are many contacts. The pairs are
+ * owned by the collision system and only valid during the callback.
+ */
+class CollisionBatchEvent : public Event
+{
+public:
+	CollisionBatchEvent(const std::vector<CollisionPair>& entered, const std::vector<CollisionPair>& staying, const std::vector<CollisionPair>& exited)
+		: entered(entered)
+		, staying(staying)
+		, exited(exited)
+	{
+	}
+
+public:
+	const std::vector<CollisionPair>& entered;
+	const std::vector<CollisionPair>& staying;
+	const std::vector<CollisionPair>& exited;
+};
+
 
 
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../ECS/ECS.h"
+#include "../EventBus/Event.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Emitted every update an entity touches solid tiles and once more when it stops touching them.
+ * Compare isTouching and wasTouching to react only when the contact starts or ends.
+ */
+class TileCollisionEvent : public Event
+{
+public:
+	TileCollisionEvent(Entity entity, const bool isTouching, const bool wasTouching, const glm::vec2& penetration)
+		: entity(entity), isTouching(isTouching), wasTouching(wasTouching), penetration(penetration) {}
+
+public:
+	Entity entity;
+	bool isTouching;
+	bool wasTouching;
+	// Moves the collider box out of the tiles, zero if only the swept box touches them.
+	glm::vec2 penetration;
+};
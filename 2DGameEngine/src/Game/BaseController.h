@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include "../Renderer/RenderStats.h"
+
 class Game;
 class Registry;
 class AssetStore;
@@ -22,13 +24,32 @@ public:
 
 	virtual void Initialize(SDL_Renderer& renderer, sol::state& lua) = 0;
 	virtual void HandleEvent(SDL_Event& sdlEvent) = 0;
-	virtual void Update(const unsigned deltaTimeMs) = 0;
+	virtual void Update(const float deltaTimeSec) = 0;
 	virtual void Render(SDL_Renderer& renderer) = 0;
 
+	/**
+	 * @brief Threaded rendering, for controllers that can draw from a recorded frame.
+	 *
+	 * RecordFrame runs on the simulation thread after Update and must not call SDL.
+	 * SubmitFrame draws the frame recorded before the last SwapFrames on the main
+	 * thread, while the simulation records the next one. It must not read any entity.
+	 */
+	virtual bool CanRecordFrame() const { return false; }
+	virtual void RecordFrame() {}
+	virtual void SwapFrames() {}
+	virtual void SubmitFrame(SDL_Renderer& renderer) {}
+
+	/**
+	 * @brief Counters of the last frame drawn by Render or SubmitFrame.
+	 */
+	inline const RenderStats& GetRenderStats() const { return renderStats; }
+
 protected:
 	Game& game;
 	Registry& registry;
 
+	RenderStats renderStats;
+
 };
 
 
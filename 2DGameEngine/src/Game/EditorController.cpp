@@ -71,6 +71,13 @@ void EditorController::HandleEvent(SDL_Event& sdlEvent)
 		case SDL_MOUSEMOTION: {
 			EventBus& eventBus = game.GetEventBus();
 			eventBus.EmitEvents<MouseMotionEvent>(sdlEvent.motion);
+			break;
+		}
+
+		case SDL_RENDER_TARGETS_RESET: {
+			// Content of the baked tilemap chunks is lost.
+			sceneManager.GetTileMap().MarkAllDirty();
+			break;
 		}
 
 		default:
@@ -79,10 +86,8 @@ void EditorController::HandleEvent(SDL_Event& sdlEvent)
 
 }
 
-void EditorController::Update(const unsigned deltaTimeMs)
+void EditorController::Update(const float deltaTimeSec)
 {
-	const float deltaTimeSec = deltaTimeMs / 1000.0f;
-
 	// Reset all the event handlers
 	EventBus& eventBus = game.GetEventBus();
 	eventBus.Reset();
@@ -104,9 +109,11 @@ void EditorController::Render(SDL_Renderer& renderer)
 	AssetStore& assetStore = game.GetAssetStore();
 	SDL_Rect& camera = game.GetCamera();
 
-	registry.GetSystem<RenderEditorSystem>().Update(sceneManager, renderer, assetStore, camera);
-	registry.GetSystem<RenderTextSystem>().Update(renderer, assetStore, camera);
-	registry.GetSystem<RenderEditorGUISystem>().Update(registry, sceneManager, renderer, assetStore);
+	renderStats.Reset();
+
+	registry.GetSystem<RenderEditorSystem>().Update(sceneManager, renderer, assetStore, camera, renderStats);
+	registry.GetSystem<RenderTextSystem>().Update(renderer, assetStore, camera, renderStats);
+	registry.GetSystem<RenderEditorGUISystem>().Update(registry, sceneManager, renderer, assetStore, renderStats);
 }
 
 void EditorController::InitializeCamera()
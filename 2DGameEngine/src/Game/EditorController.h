@@ -11,7 +11,7 @@ public:
 
 	virtual void Initialize(SDL_Renderer& renderer, sol::state& lua) override;
 	virtual void HandleEvent(SDL_Event& sdlEvent) override;
-	virtual void Update(const unsigned deltaTimeMs) override;
+	virtual void Update(const float deltaTimeSec) override;
 	virtual void Render(SDL_Renderer& renderer) override;
 
 	void CreateTileEntity();
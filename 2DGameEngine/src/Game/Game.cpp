@@ -49,6 +49,8 @@
 #include <imgui/imgui_impl_sdlrenderer.h>
 
 #include <string>
+#include <cstdio>
+#include <cmath>
 
 int Game::windowWidth;
 int Game::windowHeight;
@@ -57,10 +59,16 @@ int Game::mapHeight;
 
 Game::Game()
 	: isRunning(false)
-	, elapsedTimeMs(0)
+	, elapsedTimeMs(0.0)
+	, frameCount(0)
+	, renderTimeTicks(0)
 	, window(nullptr)
 	, renderer(nullptr)
+	, frameSurface(nullptr)
 	, camera()
+	, tickAccumulatorMs(0.0)
+	, previousCamera()
+	, renderAlpha(1.0f)
 	, registry()
 	, assetStore()
 	, eventBus()
@@ -78,8 +86,16 @@ Game::~Game()
 	Logger::Log("Game destructor called.");
 }
 
-void Game::Initialize()
+void Game::Initialize(const GameSettings& settings)
 {
+	this->settings = settings;
+
+	if (settings.isHeadless) {
+		// Build machines have no display and no audio device.
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+	}
+
 	if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
 		Logger::Log("Error initializing SDL.");
 		return;
@@ -89,15 +105,49 @@ void Game::Initialize()
 		Logger::Log("Error initializing SDL TTF.");
 	}
 	
+	const bool isRendererCreated = settings.isHeadless ? CreateOffscreenRenderer() : CreateDisplayRenderer();
+	if (!isRendererCreated) {
+		return;
+	}
+
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
+
+	ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
+	ImGui_ImplSDLRenderer_Init(renderer);
+
+	InitializeCamera();
+	previousCamera = camera;
+
+	// Headless frames never wait, their times show how long the frames really take.
+	framePacer.Reset(settings.isHeadless ? FramePacingMode::PACING_uncapped : settings.pacingMode, settings.targetFps);
+
+	if (settings.controllerType == ControllerType::CONTROLLER_game) {
+		controller = std::make_unique<GameController>(*this, *registry);
+	}
+	else {
+		controller = std::make_unique<EditorController>(*this, *registry);
+	}
+	controller->Initialize(*renderer, lua);
+
+	isRunning = true;
+}
+
+/**
+ * @brief Borderless window covering the display, unless a size is set, with an accelerated renderer.
+ */
+bool Game::CreateDisplayRenderer()
+{
 	SDL_DisplayMode displayMode;
 	if (SDL_GetCurrentDisplayMode(0, &displayMode) != 0) {
 		Logger::Err("Error getting current display mode.");
 	}
 
-	windowWidth = displayMode.w;
-	windowHeight = displayMode.h;
-	/*windowWidth = 1200;
-	windowHeight = 900;*/
+	windowWidth = settings.width > 0 ? settings.width : displayMode.w;
+	windowHeight = settings.height > 0 ? settings.height : displayMode.h;
 
 	window = SDL_CreateWindow(
 		nullptr,
@@ -110,51 +160,140 @@ void Game::Initialize()
 
 	if (!window) {
 		Logger::Err("Error creating SDL window.");
-		return;
+		return false;
 	}
 
-	renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+	Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+	if (settings.pacingMode == FramePacingMode::PACING_vsync) {
+		rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+
+	renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 	if (!renderer) {
 		Logger::Err("Error creating SDL renderer.");
-		return;
+		return false;
 	}
 
-	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+	return true;
+}
 
-	ImGui::CreateContext();
-	ImGuiIO& io = ImGui::GetIO();
-	io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     // Enable Keyboard Controls
+/**
+ * @brief Software renderer drawing into a surface. The hidden window on the dummy driver only
+ * feeds ImGui and the input functions.
+ */
+bool Game::CreateOffscreenRenderer()
+{
+	windowWidth = settings.width > 0 ? settings.width : 1280;
+	windowHeight = settings.height > 0 ? settings.height : 720;
 
-	ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
-	ImGui_ImplSDLRenderer_Init(renderer);
+	window = SDL_CreateWindow(nullptr, 0, 0, windowWidth, windowHeight, SDL_WINDOW_HIDDEN);
+	if (!window) {
+		Logger::Err("Error creating hidden SDL window: " + std::string(SDL_GetError()));
+		return false;
+	}
 
-	InitializeCamera();
+	frameSurface = SDL_CreateRGBSurfaceWithFormat(0, windowWidth, windowHeight, 32, SDL_PIXELFORMAT_RGBA32);
+	if (!frameSurface) {
+		Logger::Err("Error creating offscreen surface: " + std::string(SDL_GetError()));
+		return false;
+	}
 
-	//controller = std::make_unique<GameController>(*this, *registry);
-	controller = std::make_unique<EditorController>(*this, *registry);
-	controller->Initialize(*renderer, lua);
+	renderer = SDL_CreateSoftwareRenderer(frameSurface);
+	if (!renderer) {
+		Logger::Err("Error creating software renderer: " + std::string(SDL_GetError()));
+		return false;
+	}
 
-	isRunning = true;
+	return true;
 }
 
 void Game::Destroy()
 {
+	if (frameCount > 0) {
+		const double renderTimeMs = 1000.0 * renderTimeTicks / SDL_GetPerformanceFrequency();
+		Logger::Log("Rendered " + std::to_string(frameCount) + " frames, average render time: " + std::to_string(renderTimeMs / frameCount) + " ms");
+	}
+
+	const FrameTimeStats frameStats = framePacer.GetStats();
+	if (frameStats.numFrames > 0) {
+		char statsText[160];
+		snprintf(statsText, sizeof(statsText), "Frame time average %.2f ms, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms, jitter %.2f ms",
+			frameStats.averageMs, frameStats.p50Ms, frameStats.p90Ms, frameStats.p99Ms, frameStats.maxMs, frameStats.jitterMs);
+		Logger::Log(statsText);
+	}
+
 	ImGui_ImplSDLRenderer_Shutdown();
 	ImGui_ImplSDL2_Shutdown();
 	ImGui::DestroyContext();
 
 	SDL_DestroyWindow(window);
 	SDL_DestroyRenderer(renderer);
+	SDL_FreeSurface(frameSurface);
 	SDL_Quit();
 }
 
 void Game::Run()
 {
+	if (settings.isRenderThreaded) {
+		RunThreaded();
+		return;
+	}
+
 	while (isRunning) {
 		ProcessInput();
 		Update();
 		Render();
+
+		if (HasReachedFrameLimit()) {
+			isRunning = false;
+		}
+	}
+}
+
+/**
+ * @brief Simulates the next frame on the simulation thread while drawing the last recorded one.
+ *
+ * Frames are drawn one frame late. Input is handled while the simulation thread is
+ * idle, so the controller never sees two threads at once.
+ */
+void Game::RunThreaded()
+{
+	bool hasRecordedFrame = false;
+
+	while (isRunning) {
+		simulationThread.Wait();
+		ProcessInput();
+
+		if (!controller->CanRecordFrame()) {
+			Update();
+			Render();
+			hasRecordedFrame = false;
+		}
+		else {
+			controller->SwapFrames();
+			simulationThread.Start([this]() {
+				Update();
+				controller->RecordFrame();
+			});
+
+			if (hasRecordedFrame) {
+				Render(true);
+			}
+
+			hasRecordedFrame = true;
+		}
+
+		if (HasReachedFrameLimit()) {
+			isRunning = false;
+		}
 	}
+
+	simulationThread.Wait();
+}
+
+bool Game::HasReachedFrameLimit() const
+{
+	return settings.numFrames > 0 && frameCount >= settings.numFrames;
 }
 
 void Game::ProcessInput()
@@ -184,37 +323,124 @@ void Game::ProcessInput()
 
 void Game::Update()
 {
-	// If we are running faster than FPS, then waste some time by yielding to match FPS.
-	unsigned deltaTimeMs = static_cast<unsigned>(SDL_GetTicks64() - elapsedTimeMs);
-	if (deltaTimeMs < MILISEC_PER_FRAME) {
-		const Uint32 timeToWait = static_cast<Uint32>(MILISEC_PER_FRAME - deltaTimeMs);
-		SDL_Delay(timeToWait);
+	double deltaTimeMs = 1000.0 / (settings.targetFps > 0 ? settings.targetFps : 60);
+
+	if (settings.isHeadless) {
+		// Fixed steps without waiting, so runs are repeatable and as fast as the frames can be drawn.
+		framePacer.BeginFrame();
 	}
-	
-	deltaTimeMs = static_cast<unsigned>(SDL_GetTicks64() - elapsedTimeMs);
-	elapsedTimeMs = SDL_GetTicks64();
+	else {
+		deltaTimeMs = framePacer.BeginFrame();
+		if (deltaTimeMs > MAX_FRAME_DELTA_TIME_MS) {
+			deltaTimeMs = MAX_FRAME_DELTA_TIME_MS;
+		}
+	}
+
+	elapsedTimeMs += deltaTimeMs;
+
+	if (settings.tickRate == 0) {
+		previousCamera = camera;
+		renderAlpha = 1.0f;
+		controller->Update(static_cast<float>(deltaTimeMs / 1000.0));
+		return;
+	}
+
+	RunTicks(deltaTimeMs);
+}
+
+/**
+ * @brief Advances the simulation by whole ticks of 1 / tickRate seconds, the remaining time carries over to the next frame.
+ *
+ * The simulation then behaves the same at any frame rate. Frames are drawn between
+ * the last two ticks, by renderAlpha.
+ */
+void Game::RunTicks(const double deltaTimeMs)
+{
+	const double tickMs = 1000.0 / settings.tickRate;
+	const float tickSec = 1.0f / settings.tickRate;
+
+	tickAccumulatorMs += deltaTimeMs;
 
-	if (deltaTimeMs > FRAME_LIMITER_MAX_DELTA_TIME) {
-		deltaTimeMs = FRAME_LIMITER_MAX_DELTA_TIME;
+	unsigned numTicks = 0;
+	while (tickAccumulatorMs >= tickMs && numTicks < MAX_TICKS_PER_FRAME) {
+		previousCamera = camera;
+		controller->Update(tickSec);
+		tickAccumulatorMs -= tickMs;
+		++numTicks;
 	}
 
-	controller->Update(deltaTimeMs);
+	if (tickAccumulatorMs >= tickMs) {
+		// Fell behind, drop the time instead of catching up over the next frames.
+		tickAccumulatorMs = std::fmod(tickAccumulatorMs, tickMs);
+	}
+
+	renderAlpha = static_cast<float>(tickAccumulatorMs / tickMs);
+}
+
+/**
+ * @brief The camera between its last two ticks, by the render alpha.
+ */
+SDL_Rect Game::GetRenderCamera() const
+{
+	SDL_Rect renderCamera = camera;
+	renderCamera.x = static_cast<int>(std::lround(glm::mix<float>(static_cast<float>(previousCamera.x), static_cast<float>(camera.x), renderAlpha)));
+	renderCamera.y = static_cast<int>(std::lround(glm::mix<float>(static_cast<float>(previousCamera.y), static_cast<float>(camera.y), renderAlpha)));
+	return renderCamera;
 }
 
-void Game::Render()
+/**
+ * @param isRecordedFrame Draw the frame the controller recorded on the simulation thread, instead of reading the registry.
+ */
+void Game::Render(const bool isRecordedFrame)
 {
+	const Uint64 renderStartTicks = SDL_GetPerformanceCounter();
+
 	SDL_SetRenderDrawColor(renderer, 21, 21, 21, 255);
 	SDL_RenderClear(renderer);
 
-	controller->Render(*renderer);
+	if (isRecordedFrame) {
+		controller->SubmitFrame(*renderer);
+	}
+	else {
+		controller->Render(*renderer);
+	}
 
 	// Render to screen
 	SDL_RenderPresent(renderer);
+
+	renderTimeTicks += SDL_GetPerformanceCounter() - renderStartTicks;
+	++frameCount;
+
+	if (frameSurface && !settings.frameDumpDirectory.empty() && (frameCount % settings.frameDumpInterval) == 0) {
+		DumpFrame();
+	}
+}
+
+/**
+ * @brief Saves the offscreen surface of the current frame as a PNG file.
+ */
+void Game::DumpFrame()
+{
+	char fileName[32];
+	snprintf(fileName, sizeof(fileName), "frame_%05u.png", frameCount);
+
+	const std::string filePath = settings.frameDumpDirectory + "/" + fileName;
+	if (IMG_SavePNG(frameSurface, filePath.c_str()) != 0) {
+		Logger::Err("Could not save frame: " + filePath + ", " + std::string(IMG_GetError()));
+	}
+}
+
+/**
+ * @brief Counters of the last drawn frame, see RenderStats.
+ */
+const RenderStats& Game::GetRenderStats() const
+{
+	return controller->GetRenderStats();
 }
 
 u64 Game::GetElapsedTime() const
 {
-	return elapsedTimeMs;
+	return static_cast<u64>(elapsedTimeMs);
 }
 
 void Game::InitializeCamera()
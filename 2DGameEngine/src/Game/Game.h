@@ -6,17 +6,24 @@
 #include <sol/sol.hpp>
 
 #include "../ECS/ECS.h"
+#include "GameSettings.h"
+#include "../Utilities/TaskThread.h"
+#include "../Utilities/FramePacer.h"
 
 using u64 = unsigned __int64;
 
-const unsigned FPS = 120;
-const unsigned MILISEC_PER_FRAME = 1000 / FPS;
-const unsigned FRAME_LIMITER_MAX_DELTA_TIME = 4 * MILISEC_PER_FRAME; // milisecs
+// Longer frames, e.g. after a breakpoint, count as this long.
+const double MAX_FRAME_DELTA_TIME_MS = 50.0;
+
+// At most this many simulation ticks run per frame, the rest of a long frame is dropped so a slow frame cannot snowball.
+const unsigned MAX_TICKS_PER_FRAME = 4;
 
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
 
 class BaseController;
+struct RenderStats;
 class AssetStore;
 class EventBus;
 
@@ -27,24 +34,35 @@ public:
 	Game();
 	~Game();
 
-	void Initialize();
+	void Initialize(const GameSettings& settings);
 	void Destroy();
 	void Run();
 	void ProcessInput();
 	void Update();
-	void Render();
+	void Render(const bool isRecordedFrame = false);
 
 	inline sol::state& GetLuaState() { return lua; }
 	inline AssetStore& GetAssetStore() { return *assetStore; }
 	inline EventBus& GetEventBus() { return *eventBus; }
 	inline SDL_Rect& GetCamera() { return camera; }
 	inline void SetCamera(SDL_Rect newCamera) { camera = newCamera; }
+	inline float GetRenderAlpha() const { return renderAlpha; }
+	SDL_Rect GetRenderCamera() const;
+	inline const GameSettings& GetSettings() const { return settings; }
+	inline const FramePacer& GetFramePacer() const { return framePacer; }
+	const RenderStats& GetRenderStats() const;
 
 	u64 GetElapsedTime() const;
 
 
 private:
 	void InitializeCamera();
+	bool CreateDisplayRenderer();
+	bool CreateOffscreenRenderer();
+	void DumpFrame();
+	void RunThreaded();
+	void RunTicks(const double deltaTimeMs);
+	bool HasReachedFrameLimit() const;
 
 public:
 	static int windowWidth;
@@ -56,18 +74,36 @@ private:
 	
 	std::unique_ptr<BaseController> controller;
 
+	GameSettings settings;
+
 	bool isRunning;
-	u64 elapsedTimeMs = 0;
+	double elapsedTimeMs;
+	unsigned frameCount;
+	u64 renderTimeTicks;
 
 	SDL_Window* window;
 	SDL_Renderer* renderer;
+
+	// Target of the software renderer in headless mode.
+	SDL_Surface* frameSurface;
 	SDL_Rect camera;
 
+	FramePacer framePacer;
+
+	// Fixed tick state: time not simulated yet, the camera before the last tick, and how far the
+	// next tick is, from 0 to 1, to draw between the last two ticks.
+	double tickAccumulatorMs;
+	SDL_Rect previousCamera;
+	float renderAlpha;
+
 	sol::state lua;
 
 	std::unique_ptr<Registry> registry;
 	std::unique_ptr<AssetStore> assetStore;
 	std::unique_ptr<EventBus> eventBus;
 
+	// Runs Update and the frame recording while the main thread draws, with threaded rendering.
+	TaskThread simulationThread;
+
 };
 
@@ -29,6 +29,7 @@
 #include "../Systems/HealthDisplaySystem.h"
 #include "../Systems/RenderGUISystem.h"
 #include "../Systems/ScriptSystem.h"
+#include "../Systems/ParticleSystem.h"
 
 #include "../AssetStore/AssetStore.h"
 
@@ -48,6 +49,7 @@
 GameController::GameController(Game& game, Registry& registry)
 	: BaseController(game, registry)
 	, isDebugModeOn(false)
+	, recordingFrameIndex(0)
 {
 }
 
@@ -70,6 +72,7 @@ void GameController::Initialize(SDL_Renderer& renderer, sol::state& lua)
 	registry.AddSystem<ProjectileLifeCycleSystem>();
 	registry.AddSystem<HealthDisplaySystem>();
 	registry.AddSystem<ScriptSystem>();
+	registry.AddSystem<ParticleSystem>();
 
 	registry.GetSystem<ScriptSystem>().CreateLuaBindings(lua);
 
@@ -87,12 +90,14 @@ void GameController::HandleEvent(SDL_Event& sdlEvent)
 			isDebugModeOn = !isDebugModeOn;
 		}
 	}
+	else if (sdlEvent.type == SDL_RENDER_TARGETS_RESET) {
+		// Content of the baked tilemap chunks is lost.
+		registry.GetSystem<RenderSystem>().GetTileMap().MarkAllDirty();
+	}
 }
 
-void GameController::Update(const unsigned deltaTimeMs)
+void GameController::Update(const float deltaTimeSec)
 {
-	const float deltaTimeSec = deltaTimeMs / 1000.0f;
-
 	// Reset all the event handlers
 	EventBus& eventBus = game.GetEventBus();
 	eventBus.Reset();
@@ -106,6 +111,9 @@ void GameController::Update(const unsigned deltaTimeMs)
 	// Update the registry to process pending entities
 	registry.Update();
 
+	// Anything that moves in this tick is drawn from where it was before.
+	registry.GetSystem<RenderSystem>().StorePreviousPositions();
+
 	// Update all systems
 	registry.GetSystem<MovementSystem>().Update(deltaTimeSec);
 	registry.GetSystem<AnimationSystem>().Update(deltaTimeSec);
@@ -113,20 +121,70 @@ void GameController::Update(const unsigned deltaTimeMs)
 	registry.GetSystem<CameraMovementSystem>().Update(game.GetCamera());
 	registry.GetSystem<ProjectileEmitSystem>().Update(registry, deltaTimeSec);
 	registry.GetSystem<ProjectileLifeCycleSystem>().Update(deltaTimeSec);
+	registry.GetSystem<ParticleSystem>().Update(deltaTimeSec);
 	registry.GetSystem<ScriptSystem>().Update(deltaTimeSec, static_cast<double>(game.GetElapsedTime()));
 }
 
 void GameController::Render(SDL_Renderer& renderer)
 {
 	AssetStore& assetStore = game.GetAssetStore();
-	SDL_Rect& camera = game.GetCamera();
+	const SDL_Rect camera = game.GetRenderCamera();
+	const float renderAlpha = game.GetRenderAlpha();
 
-	registry.GetSystem<RenderSystem>().Update(renderer, assetStore, camera);
-	registry.GetSystem<RenderTextSystem>().Update(renderer, assetStore, camera);
-	registry.GetSystem<HealthDisplaySystem>().Update(renderer, assetStore, camera);
+	renderStats.Reset();
+
+	registry.GetSystem<RenderSystem>().Update(renderer, assetStore, camera, renderStats, renderAlpha);
+	registry.GetSystem<ParticleSystem>().Render(renderer, assetStore, camera, renderStats);
+	registry.GetSystem<RenderTextSystem>().Update(renderer, assetStore, camera, renderStats);
+	registry.GetSystem<HealthDisplaySystem>().Update(renderer, assetStore, camera, renderStats, renderAlpha);
 
 	if (isDebugModeOn) {
-		registry.GetSystem<DebugRenderSystem>().Update(renderer, camera);
-		registry.GetSystem<RenderGUISystem>().Update(registry, camera);
+		registry.GetSystem<DebugRenderSystem>().Update(renderer, camera, registry.GetSystem<CollisionSystem>(), renderStats);
+		registry.GetSystem<RenderGUISystem>().Update(registry, camera, renderStats);
 	}
 }
+
+/**
+ * @brief Debug drawing and the GUI read the registry while drawing, those frames run in sequence.
+ */
+bool GameController::CanRecordFrame() const
+{
+	return !isDebugModeOn;
+}
+
+void GameController::RecordFrame()
+{
+	const AssetStore& assetStore = game.GetAssetStore();
+
+	RecordedFrame& frame = recordedFrames[recordingFrameIndex];
+	frame.camera = game.GetRenderCamera();
+	const float renderAlpha = game.GetRenderAlpha();
+	frame.spriteQueue.Clear();
+	frame.textCommands.clear();
+	frame.healthCommands.clear();
+	frame.particles.Clear();
+	frame.stats.Reset();
+
+	registry.GetSystem<RenderSystem>().Record(frame.spriteQueue, assetStore, frame.camera, frame.stats, renderAlpha);
+	registry.GetSystem<ParticleSystem>().Record(frame.particles, assetStore, frame.camera);
+	registry.GetSystem<RenderTextSystem>().Record(frame.textCommands, assetStore, frame.camera);
+	registry.GetSystem<HealthDisplaySystem>().Record(frame.healthCommands, frame.camera, renderAlpha);
+}
+
+void GameController::SwapFrames()
+{
+	recordingFrameIndex = 1 - recordingFrameIndex;
+}
+
+void GameController::SubmitFrame(SDL_Renderer& renderer)
+{
+	const AssetStore& assetStore = game.GetAssetStore();
+
+	RecordedFrame& frame = recordedFrames[1 - recordingFrameIndex];
+	registry.GetSystem<RenderSystem>().Submit(renderer, assetStore, frame.spriteQueue, frame.camera, frame.stats);
+	registry.GetSystem<ParticleSystem>().Submit(renderer, frame.particles, frame.stats);
+	registry.GetSystem<RenderTextSystem>().Submit(renderer, frame.textCommands, frame.stats);
+	registry.GetSystem<HealthDisplaySystem>().Submit(renderer, assetStore, frame.healthCommands, frame.stats);
+
+	renderStats = frame.stats;
+}
@@ -2,6 +2,15 @@
 
 #include "BaseController.h"
 
+#include "../Renderer/RenderQueue.h"
+#include "../Systems/RenderTextSystem.h"
+#include "../Systems/HealthDisplaySystem.h"
+#include "../Systems/ParticleSystem.h"
+
+#include <SDL.h>
+#include <array>
+#include <vector>
+
 class GameController : public BaseController
 {
 public:
@@ -9,10 +18,29 @@ public:
 
 	virtual void Initialize(SDL_Renderer& renderer, sol::state& lua) override;
 	virtual void HandleEvent(SDL_Event& sdlEvent) override;
-	virtual void Update(const unsigned deltaTimeMs) override;
+	virtual void Update(const float deltaTimeSec) override;
 	virtual void Render(SDL_Renderer& renderer) override;
 
+	virtual bool CanRecordFrame() const override;
+	virtual void RecordFrame() override;
+	virtual void SwapFrames() override;
+	virtual void SubmitFrame(SDL_Renderer& renderer) override;
+
 private:
+	// Everything drawn in a frame, copied out of the registry.
+	struct RecordedFrame
+	{
+		SDL_Rect camera;
+		RenderQueue spriteQueue;
+		std::vector<TextDrawCommand> textCommands;
+		std::vector<HealthDrawCommand> healthCommands;
+		ParticleDrawList particles;
+		RenderStats stats;
+	};
+
 	bool isDebugModeOn;
+
+	std::array<RecordedFrame, 2> recordedFrames;
+	size_t recordingFrameIndex;
 };
 
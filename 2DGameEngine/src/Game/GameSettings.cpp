@@ -0,0 +1,130 @@
+#include "GameSettings.h"
+
+#include "../Logger/Logger.h"
+
+#include <cstdlib>
+#include <cstring>
+
+static bool ReadUnsigned(const char* text, unsigned& outValue)
+{
+	char* end = nullptr;
+	const long value = std::strtol(text, &end, 10);
+	if (end == text || *end != '\0' || value < 0) {
+		return false;
+	}
+
+	outValue = static_cast<unsigned>(value);
+	return true;
+}
+
+static bool ReadPacingMode(const char* text, FramePacingMode& outMode)
+{
+	if (std::strcmp(text, "fixed") == 0) {
+		outMode = FramePacingMode::PACING_fixed;
+	}
+	else if (std::strcmp(text, "vsync") == 0) {
+		outMode = FramePacingMode::PACING_vsync;
+	}
+	else if (std::strcmp(text, "uncapped") == 0) {
+		outMode = FramePacingMode::PACING_uncapped;
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Reads the options, e.g. --headless --game --threaded-render --width 1280 --height 720 --frames 600 --dump-frames out --dump-interval 60 --tick-rate 60 --pacing fixed --fps 120
+ * @return @c false if an option is unknown or its value is missing or invalid.
+ */
+bool GameSettings::ParseCommandLine(const int argc, char* argv[], GameSettings& outSettings)
+{
+	for (int i = 1; i < argc; ++i) {
+		const char* option = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(option, "--headless") == 0) {
+			outSettings.isHeadless = true;
+			continue;
+		}
+
+		if (std::strcmp(option, "--threaded-render") == 0) {
+			outSettings.isRenderThreaded = true;
+			continue;
+		}
+
+		if (std::strcmp(option, "--game") == 0) {
+			outSettings.controllerType = ControllerType::CONTROLLER_game;
+			continue;
+		}
+
+		if (std::strcmp(option, "--editor") == 0) {
+			outSettings.controllerType = ControllerType::CONTROLLER_editor;
+			continue;
+		}
+
+		if (std::strcmp(option, "--dump-frames") == 0) {
+			if (!value) {
+				Logger::Err("Missing directory for option: " + std::string(option));
+				return false;
+			}
+
+			outSettings.frameDumpDirectory = value;
+			++i;
+			continue;
+		}
+
+		if (std::strcmp(option, "--pacing") == 0) {
+			if (!value || !ReadPacingMode(value, outSettings.pacingMode)) {
+				Logger::Err("Missing or invalid value for option: " + std::string(option) + ", expected fixed, vsync or uncapped");
+				return false;
+			}
+
+			++i;
+			continue;
+		}
+
+		const bool isNumericOption = std::strcmp(option, "--width") == 0 || std::strcmp(option, "--height") == 0
+								  || std::strcmp(option, "--frames") == 0 || std::strcmp(option, "--dump-interval") == 0
+								  || std::strcmp(option, "--tick-rate") == 0 || std::strcmp(option, "--fps") == 0;
+		if (!isNumericOption) {
+			Logger::Err("Unknown option: " + std::string(option));
+			return false;
+		}
+
+		unsigned number = 0;
+		if (!value || !ReadUnsigned(value, number)) {
+			Logger::Err("Missing or invalid value for option: " + std::string(option));
+			return false;
+		}
+
+		if (std::strcmp(option, "--width") == 0) {
+			outSettings.width = static_cast<int>(number);
+		}
+		else if (std::strcmp(option, "--height") == 0) {
+			outSettings.height = static_cast<int>(number);
+		}
+		else if (std::strcmp(option, "--frames") == 0) {
+			outSettings.numFrames = number;
+		}
+		else if (std::strcmp(option, "--dump-interval") == 0) {
+			outSettings.frameDumpInterval = number;
+		}
+		else if (std::strcmp(option, "--tick-rate") == 0) {
+			outSettings.tickRate = number;
+		}
+		else {
+			outSettings.targetFps = number;
+		}
+
+		++i;
+	}
+
+	if (outSettings.frameDumpInterval == 0) {
+		outSettings.frameDumpInterval = 1;
+	}
+
+	return true;
+}
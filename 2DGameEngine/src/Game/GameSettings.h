@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+
+#include "../Utilities/FramePacer.h"
+
+enum class ControllerType
+{
+	CONTROLLER_editor,
+	CONTROLLER_game,
+};
+
+/**
+ * @brief Startup options of the game, read from the command line.
+ *
+ * In headless mode nothing is shown: SDL runs on its dummy video and audio drivers
+ * and the frames are drawn by the software renderer into an offscreen surface,
+ * which can be saved as PNG files. Frames advance by a fixed time step, as fast as
+ * they can be drawn, so runs are repeatable.
+ *
+ * With threaded rendering the simulation of a frame runs on its own thread while
+ * the main thread draws the previous one, for controllers that support it.
+ *
+ * The simulation advances in fixed ticks of 1 / tickRate seconds, independent of
+ * the frame rate, and frames are drawn between the last two ticks.
+ *
+ * Frames are paced to targetFps by default, or by the display with vsync, or not
+ * at all. The frame time statistics are logged on exit.
+ */
+struct GameSettings
+{
+	GameSettings()
+		: controllerType(ControllerType::CONTROLLER_editor)
+		, isHeadless(false)
+		, isRenderThreaded(false)
+		, width(0)
+		, height(0)
+		, numFrames(0)
+		, frameDumpInterval(1)
+		, tickRate(60)
+		, pacingMode(FramePacingMode::PACING_fixed)
+		, targetFps(120)
+	{
+	}
+
+	static bool ParseCommandLine(const int argc, char* argv[], GameSettings& outSettings);
+
+	ControllerType controllerType;
+	bool isHeadless;
+	bool isRenderThreaded;
+
+	// Window or offscreen surface size, 0 to use the display size (1280x720 when headless).
+	int width;
+	int height;
+
+	// Frames to run before quitting, 0 to run until the window is closed.
+	unsigned numFrames;
+
+	// Every frameDumpInterval-th frame is saved here, as frame_00001.png etc. Only in headless mode, empty to not save.
+	std::string frameDumpDirectory;
+	unsigned frameDumpInterval;
+
+	// Simulation ticks per second, 0 to run one tick of variable length per frame.
+	unsigned tickRate;
+
+	FramePacingMode pacingMode;
+
+	// Frames per second in fixed pacing mode, also the frame time step in headless mode.
+	unsigned targetFps;
+};
@@ -17,6 +17,12 @@
 #include "../Components/HealthComponent.h"
 #include "../Components/TextLabelComponent.h"
 #include "../Components/ScriptComponent.h"
+#include "../Components/ParticleEmitterComponent.h"
+
+#include "../Systems/CollisionSystem.h"
+#include "../Systems/RenderSystem.h"
+#include "../Renderer/TileMap.h"
+#include "../Utilities/CollisionMatrix.h"
 
 #include <sol/sol.hpp>
 
@@ -27,6 +33,62 @@
 #include <sstream>
 #include <assert.h>
 
+/**
+ * @brief Index of the first entry of a list table. Plain Lua lists start at 1,
+ * the level files also write lists with an explicit [0] entry.
+ */
+static size_t GetFirstListIndex(const sol::table& list)
+{
+	return list[0].valid() ? 0 : 1;
+}
+
+/**
+ * @brief Picks a collision layer from the tag or group of the entity
+ * for colliders that do not specify one explicitly.
+ */
+static CollisionLayer GetDefaultCollisionLayer(const Entity entity)
+{
+	if (entity.HasTag("player")) {
+		return CollisionLayer::LAYER_player;
+	}
+
+	if (entity.BelongsToGroup("enemies")) {
+		return CollisionLayer::LAYER_enemy;
+	}
+
+	if (entity.BelongsToGroup("projectiles")) {
+		return CollisionLayer::LAYER_projectile;
+	}
+
+	if (entity.BelongsToGroup("obstacles")) {
+		return CollisionLayer::LAYER_obstacle;
+	}
+
+	if (entity.BelongsToGroup("tiles")) {
+		return CollisionLayer::LAYER_tile;
+	}
+
+	return CollisionLayer::LAYER_default;
+}
+
+/**
+ * @brief Reads a color table such as { r = 255, g = 128, b = 0, a = 255 }, missing channels keep the default.
+ */
+static SDL_Color ReadColor(const sol::optional<sol::table>& colorOptional, const SDL_Color defaultColor)
+{
+	if (colorOptional == sol::nullopt) {
+		return defaultColor;
+	}
+
+	const sol::table& color = colorOptional.value();
+	return {
+		static_cast<Uint8>(color["r"].get_or(static_cast<int>(defaultColor.r))),
+		static_cast<Uint8>(color["g"].get_or(static_cast<int>(defaultColor.g))),
+		static_cast<Uint8>(color["b"].get_or(static_cast<int>(defaultColor.b))),
+		static_cast<Uint8>(color["a"].get_or(static_cast<int>(defaultColor.a)))
+	};
+}
+
 LevelLoader::LevelLoader()
 {
 }
@@ -76,6 +138,8 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 		}
 	}
 
+	assetStore.BuildAtlases(renderer);
+
 	// Read the level tilemap
 
 	const sol::table& map = level["tilemap"];
@@ -130,42 +194,72 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 		}
 	}
 
-	SDL_Texture* mapTexture = assetStore.GetTexture(mapTextureAssetId);
-	int textureWidth, textureHeight;
-	SDL_QueryTexture(mapTexture, nullptr, nullptr, &textureWidth, &textureHeight);
-	const int numTilesInTextureRow = textureWidth / tileSize;
-	const int zIndex = 0;
+	// The tiles never move, they are drawn from baked chunks instead of being entities.
+
+	if (registry.HasSystem<RenderSystem>()) {
+		TileMap& tileMap = registry.GetSystem<RenderSystem>().GetTileMap();
+		tileMap.Reset(glm::vec2(0.0f), tileSize * mapScale, tileMapIndices);
+		tileMap.SetTileset(mapTextureAssetId, tileSize);
+	}
+
+	Game::mapWidth = static_cast<int>(tileMapIndices[0].size()) * tileSize * static_cast<int>(mapScale);
+	Game::mapHeight = static_cast<int>(tileMapIndices.size()) * tileSize * static_cast<int>(mapScale);
 
-	// Create tile entities
+	// Solid tiles collide through the tile grid, e.g. solid_tiles = { 10, 11, 12 }
+
+	if (registry.HasSystem<CollisionSystem>()) {
+		std::vector<int> solidTileIndices;
+		sol::optional<sol::table> solidTilesOptional = map["solid_tiles"];
+		if (solidTilesOptional != sol::nullopt) {
+			const sol::table& solidTiles = solidTilesOptional.value();
+			for (size_t i = 1; /* noop */; ++i) {
+				sol::optional<int> tileIndexOptional = solidTiles[i];
+				if (tileIndexOptional == sol::nullopt) {
+					break;
+				}
 
-	for (size_t i = 0; i < tileMapIndices.size(); ++i) {
-		for (size_t j = 0; j < tileMapIndices[i].size(); ++j) {
-			Entity tile = registry.CreateEntity();
-			tile.Tag("tile");
-			tile.Group("tiles");
+				solidTileIndices.push_back(tileIndexOptional.value());
+			}
+		}
 
-			const glm::vec2 tilePos(j * (tileSize * mapScale), i * (tileSize * mapScale));
-			tile.AddComponent<TransformComponent>(tilePos, glm::vec2(mapScale, mapScale), 0.0f);
+		registry.GetSystem<CollisionSystem>().GetTileCollisionGrid().Build(tileMapIndices, solidTileIndices, tileSize * mapScale);
+	}
 
-			const int tileIdx = tileMapIndices[i][j];
-			if (tileIdx < 0) {
+	// Read the collision matrix overrides, applied in order, either as a plain list or starting at [0]:
+	// collision_matrix = {
+	//     { a = "player", b = "obstacle", collides = false },
+	//     { a = "enemy", b = "enemy" }, -- collides defaults to true
+	// }
+
+	sol::optional<sol::table> collisionMatrixOptional = level["collision_matrix"];
+	if (collisionMatrixOptional != sol::nullopt && registry.HasSystem<CollisionSystem>()) {
+		CollisionSystem& collisionSystem = registry.GetSystem<CollisionSystem>();
+		const sol::table& collisionMatrixEntries = collisionMatrixOptional.value();
+
+		for (size_t i = GetFirstListIndex(collisionMatrixEntries); /* noop */; ++i) {
+			sol::optional<sol::table> entryOptional = collisionMatrixEntries[i];
+			if (entryOptional == sol::nullopt) {
+				break;
+			}
+
+			const sol::table& entry = entryOptional.value();
+			const std::string layerNameA = entry["a"];
+			const std::string layerNameB = entry["b"];
+
+			CollisionLayer layerA, layerB;
+			if (!CollisionMatrix::GetLayerByName(layerNameA, layerA) || !CollisionMatrix::GetLayerByName(layerNameB, layerB)) {
+				Logger::Err("Unknown collision layer in collision matrix: " + layerNameA + ", " + layerNameB);
 				continue;
 			}
 
-			const unsigned column = tileIdx % numTilesInTextureRow;
-			const unsigned row = tileIdx / numTilesInTextureRow;
-			const int srcRectX = tileSize * column;
-			const int srcRectY = tileSize * row;
-			tile.AddComponent<SpriteComponent>(mapTextureAssetId, tileSize, tileSize, zIndex, false, srcRectX, srcRectY);
+			collisionSystem.SetLayersCollide(layerA, layerB, entry["collides"].get_or(true));
 		}
 	}
 
-	Game::mapWidth = static_cast<int>(tileMapIndices[0].size()) * tileSize * static_cast<int>(mapScale);
-	Game::mapHeight = static_cast<int>(tileMapIndices.size()) * tileSize * static_cast<int>(mapScale);
-
 	// Read the character information
 
 	const sol::table& entities = level["entities"];
+	std::vector<Entity> staticColliders;
 
 	for (size_t i = 0; /* noop */; ++i) {
 		sol::optional<sol::table> entityOptional = entities[i];
@@ -212,7 +306,8 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 		if (rigidbodyOptional != sol::nullopt) {
 			const sol::table& rigidbody = rigidbodyOptional.value();
 			newEntity.AddComponent<RigidBodyComponent>(
-				glm::vec2(rigidbody["velocity"]["x"].get_or(0.0f), rigidbody["velocity"]["y"].get_or(0.0f))
+				glm::vec2(rigidbody["velocity"]["x"].get_or(0.0f), rigidbody["velocity"]["y"].get_or(0.0f)),
+				rigidbody["continuous_collision"].get_or(false)
 			);
 		}
 
@@ -248,10 +343,25 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 		sol::optional<sol::table> boxColliderOptional = components["box_collider"];
 		if (boxColliderOptional != sol::nullopt) {
 			const sol::table& boxCollider = boxColliderOptional.value();
+
+			CollisionLayer layer = GetDefaultCollisionLayer(newEntity);
+			sol::optional<std::string> layerOptional = boxCollider["layer"];
+			if (layerOptional != sol::nullopt && !CollisionMatrix::GetLayerByName(layerOptional.value(), layer)) {
+				Logger::Err("Unknown collision layer: " + layerOptional.value());
+			}
+
+			const std::string shapeName = boxCollider["shape"].get_or(std::string("box"));
+			if (shapeName != "box" && shapeName != "circle") {
+				Logger::Err("Unknown collider shape: " + shapeName);
+			}
+
 			newEntity.AddComponent<BoxColliderComponent>(
 				boxCollider["width"],
 				boxCollider["height"],
-				glm::vec2(boxCollider["offset"]["x"].get_or(0), boxCollider["offset"]["y"].get_or(0))
+				glm::vec2(boxCollider["offset"]["x"].get_or(0), boxCollider["offset"]["y"].get_or(0)),
+				layer,
+				static_cast<CollisionMask>(boxCollider["mask"].get_or(COLLISION_MASK_ALL)),
+				(shapeName == "circle") ? ColliderShape::SHAPE_circle : ColliderShape::SHAPE_box
 			);
 		}
 
@@ -279,6 +389,29 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 			);
 		}
 
+		// Particle Emitter
+
+		sol::optional<sol::table> particleEmitterOptional = components["particle_emitter"];
+		if (particleEmitterOptional != sol::nullopt) {
+			const sol::table& particleEmitter = particleEmitterOptional.value();
+			newEntity.AddComponent<ParticleEmitterComponent>(
+				particleEmitter["texture_asset_id"].get_or(std::string()),
+				particleEmitter["emit_rate"].get_or(0.0f),
+				static_cast<unsigned>(particleEmitter["burst_count"].get_or(0)),
+				particleEmitter["min_lifetime"].get_or(0.5f),
+				particleEmitter["max_lifetime"].get_or(1.0f),
+				particleEmitter["min_speed"].get_or(20.0f),
+				particleEmitter["max_speed"].get_or(60.0f),
+				particleEmitter["direction"].get_or(0.0f),
+				particleEmitter["spread"].get_or(360.0f),
+				glm::vec2(particleEmitter["acceleration"]["x"].get_or(0.0f), particleEmitter["acceleration"]["y"].get_or(0.0f)),
+				particleEmitter["start_size"].get_or(4.0f),
+				particleEmitter["end_size"].get_or(0.0f),
+				ReadColor(particleEmitter["start_color"], { 255, 255, 255, 255 }),
+				ReadColor(particleEmitter["end_color"], { 255, 255, 255, 0 })
+			);
+		}
+
 		// Keyboard Controller
 
 		sol::optional<sol::table> keyboardControllerOptional = components["keyboard_controller"];
@@ -311,10 +444,20 @@ void LevelLoader::LoadLevel(sol::state& lua, Registry& registry, AssetStore& ass
 			newEntity.AddComponent<ScriptComponent>(func);
 		}
 
+		if (newEntity.HasComponent<BoxColliderComponent>() && newEntity.HasComponent<TransformComponent>()
+			&& CollisionSystem::IsStaticCollider(newEntity)) {
+			staticColliders.push_back(newEntity);
+		}
+
 	}
 
 
 
+	// Obstacles and other colliders without a rigidbody or script never move, bake them once.
+	if (registry.HasSystem<CollisionSystem>()) {
+		registry.GetSystem<CollisionSystem>().BakeStaticColliders(staticColliders);
+	}
+
 	/*Entity label = registry.CreateEntity();
 	SDL_Color labelColor = { 10, 220, 200 };
 	const bool isLabelFixed = true;
@@ -1,8 +1,7 @@
 #include "SceneManager.h"
 
-#include "../Components/TransformComponent.h"
-#include "../Components/SpriteComponent.h"
 #include "../ECS/ECS.h"
+#include "../Logger/Logger.h"
 
 #include <assert.h>
 
@@ -15,6 +14,7 @@ SceneManager::SceneManager(Registry& registry, const SDL_Rect& camera)
 	, tileMapIndices()
 {
 	tileMapIndices.assign(gridProperties.cellCountY, std::vector<int>(gridProperties.cellCountX, -1));
+	tileMap.Reset(glm::vec2(gridProperties.startPos), static_cast<float>(gridProperties.cellSize), tileMapIndices);
 }
 
 // TODO: move construct, RVO check
@@ -36,16 +36,23 @@ void SceneManager::AddActiveTile()
 {
 	assert(HasActiveTile());
 
-	Entity tile = registry.CreateEntity();
-	tile.Tag("tile");
-	tile.Group("tiles");
-	tile.AddComponent<TransformComponent>(activeTile.posWorld, glm::vec2(1, 1), 0.0f);
-	tile.AddComponent<SpriteComponent>(activeTile.assetId, activeTile.width, activeTile.height, 1, false, activeTile.uvX, activeTile.uvY);
-	
+	// The map has a single tileset like the saved map file, tiles from another tileset are refused
+	// instead of re-skinning the whole map.
+	const std::string& tilesetAssetId = tileMap.GetTilesetAssetId();
+	if (!tilesetAssetId.empty() && tilesetAssetId != activeTile.assetId)
+	{
+		Logger::Err("Tile from tileset " + activeTile.assetId + " not placed, the map uses tileset " + tilesetAssetId);
+		return;
+	}
+
 	const glm::ivec2 relativeCenterPos = activeTile.posWorld - gridProperties.startPos + glm::ivec2(activeTile.width / 2, activeTile.height / 2);
 	const int gridIdxX = relativeCenterPos.x / gridProperties.cellSize;
 	const int gridIdxY = relativeCenterPos.y / gridProperties.cellSize;
 	tileMapIndices[gridIdxY][gridIdxX] = activeTile.srcIndexLinear;
+
+	// Tiles are drawn from the tilemap chunks, only the chunk of this tile is baked again.
+	tileMap.SetTileset(activeTile.assetId, activeTile.width);
+	tileMap.SetTile(gridIdxY, gridIdxX, activeTile.srcIndexLinear);
 }
 
 bool GridProperties::isInside(const int x, const int y) const
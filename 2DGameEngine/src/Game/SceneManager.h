@@ -5,6 +5,8 @@
 #include <glm/glm.hpp>
 #include <SDL.h>
 
+#include "../Renderer/TileMap.h"
+
 class Registry;
 
 struct TileProperties
@@ -53,6 +55,7 @@ public:
 	inline void SetGridSize(const int numGridsX, const int numGridsY);
 	inline const GridProperties& GetGridProperties() const;
 	inline const TileMapArray& GetTileMapIndices() const;
+	inline TileMap& GetTileMap();
 
 	void AddActiveTile();
 
@@ -64,6 +67,7 @@ private:
 	GridProperties gridProperties;
 	
 	TileMapArray tileMapIndices;
+	TileMap tileMap;
 
 public:
 	bool snapToGrid = false;
@@ -111,6 +115,11 @@ inline const SceneManager::TileMapArray& SceneManager::GetTileMapIndices() const
 	return tileMapIndices;
 }
 
+inline TileMap& SceneManager::GetTileMap()
+{
+	return tileMap;
+}
+
 
 
 
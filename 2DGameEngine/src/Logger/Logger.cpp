@@ -1,6 +1,7 @@
 #include "Logger.h"
 #include <iostream>
 #include <chrono>
+#include <mutex>
 
 #include "date.h"
 
@@ -10,6 +11,9 @@ constexpr std::string_view RESET = "\033[0m";
 
 std::vector<LogEntry> Logger::messages;
 
+// Messages come from the main and the simulation thread.
+static std::mutex messagesMutex;
+
 std::string GetCurrentDateTimeString()
 {
 	return date::format("%d/%b/%Y %X", std::chrono::system_clock::now());
@@ -20,6 +24,8 @@ void Logger::Log(const std::string &message)
 	LogEntry logEntry;
 	logEntry.type = LogType::LOG_info;
 	logEntry.message = "LOG: [" + GetCurrentDateTimeString() + " ]: " + message;
+
+	std::lock_guard<std::mutex> lock(messagesMutex);
 	messages.push_back(logEntry);
 
 	std::cout << GREEN << logEntry.message << RESET << '\n';
@@ -30,6 +36,8 @@ void Logger::Err(const std::string &message)
 	LogEntry logEntry;
 	logEntry.type = LogType::LOG_info;
 	logEntry.message = "LOG: [" + GetCurrentDateTimeString() + " ]: " + message;
+
+	std::lock_guard<std::mutex> lock(messagesMutex);
 	messages.push_back(logEntry);
 
 	std::cerr << RED << logEntry.message << RESET << '\n';
@@ -1,11 +1,17 @@
 #include "Game/Game.h"
+#include "Game/GameSettings.h"
 
 int main(int argc, char* argv[]) {
     
+    GameSettings settings;
+    if (!GameSettings::ParseCommandLine(argc, argv, settings)) {
+        return 1;
+    }
+
     Game game;
-    game.Initialize();
+    game.Initialize(settings);
     game.Run();
     game.Destroy();
 
     return 0;
-}
\ No newline at end of file
+}
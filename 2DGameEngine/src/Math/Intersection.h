@@ -1,8 +1,11 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <utility>
 
-bool findIntersection(glm::vec2& out, const glm::vec2 p0, const glm::vec2 p1, const glm::vec2 p2, const glm::vec2 p3)
+#include "../Utilities/Geometry.h"
+
+inline bool findIntersection(glm::vec2& out, const glm::vec2 p0, const glm::vec2 p1, const glm::vec2 p2, const glm::vec2 p3)
 {
 	const float a1 = p1.y - p0.y;
 	const float b1 = p0.x - p1.x;
@@ -26,4 +29,79 @@ bool findIntersection(glm::vec2& out, const glm::vec2 p0, const glm::vec2 p1, co
 	return true;
 }
 
+/**
+ * @brief Intersects the segment p0 -> p1 with the box using the slab method.
+ * @param outFraction Fraction along the segment where it enters the box, 0 if p0 is inside.
+ * @return @c true if the segment touches the box, else @c false.
+ */
+inline bool findIntersection(float& outFraction, const glm::vec2 p0, const glm::vec2 p1, const Aabb& aabb)
+{
+	const glm::vec2 direction = p1 - p0;
+
+	float tMin = 0.0f;
+	float tMax = 1.0f;
+
+	for (int axis = 0; axis < 2; ++axis) {
+		if (direction[axis] == 0.0f) {
+			// Segment is parallel to the slab, it must start inside of it.
+			if (p0[axis] < aabb.min[axis] || p0[axis] > aabb.max[axis]) {
+				return false;
+			}
+
+			continue;
+		}
+
+		const float inverseDirection = 1.0f / direction[axis];
+		float tNear = (aabb.min[axis] - p0[axis]) * inverseDirection;
+		float tFar = (aabb.max[axis] - p0[axis]) * inverseDirection;
+		if (tNear > tFar) {
+			std::swap(tNear, tFar);
+		}
 
+		tMin = glm::max(tMin, tNear);
+		tMax = glm::min(tMax, tFar);
+		if (tMin > tMax) {
+			return false;
+		}
+	}
+
+	outFraction = tMin;
+	return true;
+}
+
+/**
+ * @brief Separating axis test of two oriented boxes. Touching boxes overlap.
+ */
+inline bool testOverlap(const Obb& a, const Obb& b)
+{
+	const glm::vec2 distance = b.center - a.center;
+
+	for (const glm::vec2& axis : { a.axisX, a.axisY, b.axisX, b.axisY }) {
+		const float radiusA = a.halfExtents.x * glm::abs(glm::dot(a.axisX, axis)) + a.halfExtents.y * glm::abs(glm::dot(a.axisY, axis));
+		const float radiusB = b.halfExtents.x * glm::abs(glm::dot(b.axisX, axis)) + b.halfExtents.y * glm::abs(glm::dot(b.axisY, axis));
+		if (glm::abs(glm::dot(distance, axis)) > radiusA + radiusB) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+inline bool testOverlap(const Circle& a, const Circle& b)
+{
+	const glm::vec2 distance = b.center - a.center;
+	const float radiusSum = a.radius + b.radius;
+	return glm::dot(distance, distance) <= radiusSum * radiusSum;
+}
+
+/**
+ * @brief Finds the point of the box closest to the circle center and compares its distance to the radius.
+ */
+inline bool testOverlap(const Circle& circle, const Obb& box)
+{
+	const glm::vec2 distance = circle.center - box.center;
+	const glm::vec2 localCenter(glm::dot(distance, box.axisX), glm::dot(distance, box.axisY));
+	const glm::vec2 localClosest = glm::clamp(localCenter, -box.halfExtents, box.halfExtents);
+	const glm::vec2 offset = localCenter - localClosest;
+	return glm::dot(offset, offset) <= circle.radius * circle.radius;
+}
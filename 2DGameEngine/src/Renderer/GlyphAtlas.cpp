@@ -0,0 +1,114 @@
+#include "GlyphAtlas.h"
+
+#include "SpriteBatch.h"
+#include "../Logger/Logger.h"
+
+#include <vector>
+
+GlyphAtlas::GlyphAtlas()
+	: texture(nullptr)
+{
+	Clear();
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+	Clear();
+}
+
+/**
+ * @brief Renders the characters in a single row. Surfaces of TTF_RenderGlyph_Blended span the font height,
+ * so every glyph keeps its offset to the baseline.
+ */
+bool GlyphAtlas::Build(SDL_Renderer& renderer, TTF_Font* font, const std::string& characters)
+{
+	Clear();
+
+	if (!font) {
+		return false;
+	}
+
+	const SDL_Color white = { 255, 255, 255, 255 };
+
+	std::vector<std::pair<char, SDL_Surface*>> glyphSurfaces;
+	glm::ivec2 atlasSize(0, 0);
+	for (const char character : characters) {
+		if (character < 0 || glyphs[character].isValid) {
+			continue;
+		}
+
+		SDL_Surface* glyphSurface = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(character), white);
+		if (!glyphSurface) {
+			Logger::Err("Could not render glyph: " + std::string(1, character));
+			continue;
+		}
+
+		// Glyphs are 1 pixel apart, so linear filtering does not bleed between them.
+		glyphs[character] = { { atlasSize.x, 0, glyphSurface->w, glyphSurface->h }, true };
+		atlasSize.x += glyphSurface->w + 1;
+		atlasSize.y = glm::max(atlasSize.y, glyphSurface->h);
+		glyphSurfaces.emplace_back(character, glyphSurface);
+	}
+
+	bool isBuilt = false;
+	if (!glyphSurfaces.empty()) {
+		SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasSize.x, atlasSize.y, 32, SDL_PIXELFORMAT_RGBA32);
+		if (atlasSurface) {
+			for (auto& glyphSurface : glyphSurfaces) {
+				SDL_Rect rect = glyphs[glyphSurface.first].rect;
+				SDL_SetSurfaceBlendMode(glyphSurface.second, SDL_BLENDMODE_NONE);
+				SDL_BlitSurface(glyphSurface.second, nullptr, atlasSurface, &rect);
+			}
+
+			texture = SDL_CreateTextureFromSurface(&renderer, atlasSurface);
+			SDL_FreeSurface(atlasSurface);
+		}
+
+		if (texture) {
+			SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+			isBuilt = true;
+		}
+		else {
+			Logger::Err("Could not create the glyph atlas texture.");
+		}
+	}
+
+	for (auto& glyphSurface : glyphSurfaces) {
+		SDL_FreeSurface(glyphSurface.second);
+	}
+
+	if (!isBuilt) {
+		Clear();
+	}
+
+	return isBuilt;
+}
+
+void GlyphAtlas::Clear()
+{
+	if (texture) {
+		SDL_DestroyTexture(texture);
+		texture = nullptr;
+	}
+
+	glyphs.fill({ { 0, 0, 0, 0 }, false });
+}
+
+void GlyphAtlas::DrawText(SpriteBatch& spriteBatch, const char* text, const glm::vec2& position, const SDL_Color& color) const
+{
+	if (!texture) {
+		return;
+	}
+
+	float penX = position.x;
+	for (const char* character = text; *character; ++character) {
+		if (*character < 0 || !glyphs[*character].isValid) {
+			continue;
+		}
+
+		const SDL_Rect& rect = glyphs[*character].rect;
+		const SDL_FRect destRect = { penX, position.y, static_cast<float>(rect.w), static_cast<float>(rect.h) };
+		spriteBatch.Draw(texture, rect, destRect, 0.0, SDL_FLIP_NONE, 0, color);
+		penX += rect.w;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <string>
+
+class SpriteBatch;
+
+/**
+ * @brief A fixed set of ASCII glyphs of one font, rendered once into a single white texture.
+ *
+ * Text is drawn as one quad per glyph through a SpriteBatch and tinted by the
+ * vertex color, so many labels cost a single draw call. Glyphs are placed by
+ * their advance only, there is no kerning.
+ */
+class GlyphAtlas
+{
+public:
+	GlyphAtlas();
+	~GlyphAtlas();
+
+	GlyphAtlas(const GlyphAtlas&) = delete;
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+	bool Build(SDL_Renderer& renderer, TTF_Font* font, const std::string& characters);
+	void Clear();
+
+	inline bool IsBuilt() const { return texture != nullptr; }
+
+	/**
+	 * @brief Draws the text with its top left corner at position. Characters not in the atlas are skipped.
+	 */
+	void DrawText(SpriteBatch& spriteBatch, const char* text, const glm::vec2& position, const SDL_Color& color) const;
+
+private:
+	struct Glyph
+	{
+		SDL_Rect rect;
+		bool isValid;
+	};
+
+	SDL_Texture* texture;
+	std::array<Glyph, 128> glyphs;
+};
@@ -0,0 +1,102 @@
+#include "RenderQueue.h"
+
+#include <assert.h>
+#include <utility>
+
+const int RadixBits = 8;
+const size_t RadixBuckets = size_t(1) << RadixBits;
+
+// Only layer, zIndex and texture id are set, the lowest bits are always zero.
+const int SortKeyFirstBit = 24;
+const int SortKeyBits = 64;
+
+const int ZIndexBias = 1 << 15;
+
+RenderQueue::RenderQueue()
+{
+}
+
+void RenderQueue::Clear()
+{
+	commands.clear();
+	sortKeys.clear();
+	sortedIndices.clear();
+}
+
+void RenderQueue::Push(const uint8_t layer, const int zIndex, SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect,
+					   const double rotation, const SDL_RendererFlip flip)
+{
+	sortKeys.push_back(MakeSortKey(layer, zIndex, GetTextureId(texture)));
+	sortedIndices.push_back(static_cast<uint32_t>(commands.size()));
+	commands.push_back({ texture, srcRect, destRect, static_cast<float>(rotation), flip, zIndex });
+}
+
+/**
+ * @brief LSD radix sort of the keys, one byte per pass. Passes where all keys share the byte are skipped.
+ */
+void RenderQueue::Sort()
+{
+	const size_t numCommands = sortKeys.size();
+	if (numCommands < 2) {
+		return;
+	}
+
+	scratchKeys.resize(numCommands);
+	scratchIndices.resize(numCommands);
+
+	for (int shift = SortKeyFirstBit; shift < SortKeyBits; shift += RadixBits) {
+		size_t bucketOffsets[RadixBuckets] = {};
+		for (const uint64_t key : sortKeys) {
+			++bucketOffsets[(key >> shift) & (RadixBuckets - 1)];
+		}
+
+		if (bucketOffsets[(sortKeys[0] >> shift) & (RadixBuckets - 1)] == numCommands) {
+			continue;
+		}
+
+		size_t offset = 0;
+		for (size_t& bucketOffset : bucketOffsets) {
+			const size_t count = bucketOffset;
+			bucketOffset = offset;
+			offset += count;
+		}
+
+		for (size_t i = 0; i < numCommands; ++i) {
+			const size_t destination = bucketOffsets[(sortKeys[i] >> shift) & (RadixBuckets - 1)]++;
+			scratchKeys[destination] = sortKeys[i];
+			scratchIndices[destination] = sortedIndices[i];
+		}
+
+		sortKeys.swap(scratchKeys);
+		sortedIndices.swap(scratchIndices);
+	}
+}
+
+void RenderQueue::Submit(SpriteBatch& spriteBatch) const
+{
+	for (const uint32_t commandIndex : sortedIndices) {
+		const RenderCommand& command = commands[commandIndex];
+		spriteBatch.Draw(command.texture, command.srcRect, command.destRect, command.rotation, command.flip, command.zIndex);
+	}
+}
+
+uint64_t RenderQueue::MakeSortKey(const uint8_t layer, const int zIndex, const uint16_t textureId)
+{
+	assert(-ZIndexBias <= zIndex && zIndex < ZIndexBias);
+	const uint64_t biasedZIndex = static_cast<uint16_t>(zIndex + ZIndexBias);
+
+	return (uint64_t(layer) << 56) | (biasedZIndex << 40) | (uint64_t(textureId) << SortKeyFirstBit);
+}
+
+uint16_t RenderQueue::GetTextureId(SDL_Texture* texture)
+{
+	auto textureIdIt = textureIds.find(texture);
+	if (textureIdIt != textureIds.end()) {
+		return textureIdIt->second;
+	}
+
+	assert(textureIds.size() <= UINT16_MAX);
+	const uint16_t textureId = static_cast<uint16_t>(textureIds.size());
+	textureIds.emplace(texture, textureId);
+	return textureId;
+}
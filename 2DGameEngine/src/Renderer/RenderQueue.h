@@ -0,0 +1,58 @@
+#pragma once
+
+#include "SpriteBatch.h"
+
+#include <SDL.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+struct RenderCommand
+{
+	SDL_Texture* texture;
+	SDL_Rect srcRect;
+	SDL_FRect destRect;
+	float rotation;
+	SDL_RendererFlip flip;
+	int zIndex;
+};
+
+/**
+ * @brief Draw commands of a frame, sorted by a 64 bit key before submission.
+ *
+ * Key layout from the most significant bit: layer (8 bits), zIndex (16 bits, biased
+ * to be unsigned) and texture id (16 bits). The keys are sorted with a stable LSD
+ * radix sort, so commands with equal keys keep their push order, and sprites of
+ * the same layer and zIndex end up grouped by texture.
+ */
+class RenderQueue
+{
+public:
+	RenderQueue();
+
+	void Clear();
+
+	void Push(const uint8_t layer, const int zIndex, SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect,
+			  const double rotation = 0.0, const SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+	void Sort();
+	void Submit(SpriteBatch& spriteBatch) const;
+
+	inline size_t GetSize() const { return commands.size(); }
+
+	static uint64_t MakeSortKey(const uint8_t layer, const int zIndex, const uint16_t textureId);
+
+private:
+	uint16_t GetTextureId(SDL_Texture* texture);
+
+private:
+	std::vector<RenderCommand> commands;
+	std::vector<uint64_t> sortKeys;
+	std::vector<uint32_t> sortedIndices;
+
+	std::vector<uint64_t> scratchKeys;
+	std::vector<uint32_t> scratchIndices;
+
+	// Ids are handed out on first use and kept, so the order of textures is stable between frames.
+	std::unordered_map<SDL_Texture*, uint16_t> textureIds;
+};
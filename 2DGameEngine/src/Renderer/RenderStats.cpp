@@ -0,0 +1,23 @@
+#include "RenderStats.h"
+
+#include <imgui/imgui.h>
+
+/**
+ * @brief Small window in the top right corner, below the editor menu bar. Must be called between ImGui::NewFrame and ImGui::Render.
+ */
+void ShowRenderStatsWindow(const RenderStats& stats)
+{
+	const ImGuiIO& io = ImGui::GetIO();
+	ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.0f, 30.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+	ImGui::SetNextWindowBgAlpha(0.9f);
+
+	const ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoNav;
+	if (ImGui::Begin("Render stats", nullptr, windowFlags)) {
+		ImGui::Text("Sprites visited: %u", stats.spritesVisited);
+		ImGui::Text("Sprites culled: %u", stats.spritesCulled);
+		ImGui::Text("Draw calls: %u", stats.drawCalls);
+		ImGui::Text("Texture switches: %u", stats.textureSwitches);
+		ImGui::Text("Text rasterizations: %u", stats.textRasterizations);
+	}
+	ImGui::End();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @brief Counters of one drawn frame, filled in by the render systems.
+ *
+ * The caller resets them at the start of the frame and passes them to every
+ * system that draws. ShowRenderStatsWindow shows them inside an ImGui frame.
+ */
+struct RenderStats
+{
+	RenderStats();
+
+	void Reset();
+
+	// Sprites checked against the camera, and how many of them were outside of it.
+	unsigned spritesVisited;
+	unsigned spritesCulled;
+
+	// SDL calls that draw: copies, geometry batches, rects and lines.
+	unsigned drawCalls;
+
+	// Draws with another texture than the draw before, including the first one.
+	unsigned textureSwitches;
+
+	// Texts rendered by SDL_ttf, i.e. misses of the text texture cache.
+	unsigned textRasterizations;
+};
+
+void ShowRenderStatsWindow(const RenderStats& stats);
+
+inline RenderStats::RenderStats()
+{
+	Reset();
+}
+
+inline void RenderStats::Reset()
+{
+	spritesVisited = 0;
+	spritesCulled = 0;
+	drawCalls = 0;
+	textureSwitches = 0;
+	textRasterizations = 0;
+}
@@ -0,0 +1,160 @@
+#include "SpriteBatch.h"
+
+#include <glm/glm.hpp>
+#include <assert.h>
+#include <utility>
+#include <cmath>
+
+const size_t InitialQuadCapacity = 1024;
+
+SpriteBatch::SpriteBatch()
+	: renderer(nullptr)
+	, currentTexture(nullptr)
+	, currentZIndex(0)
+	, inverseTextureWidth(1.0f)
+	, inverseTextureHeight(1.0f)
+	, numDrawCalls(0)
+	, numTextureSwitches(0)
+{
+	vertices.reserve(InitialQuadCapacity * 4);
+	indices.reserve(InitialQuadCapacity * 6);
+}
+
+void SpriteBatch::Begin(SDL_Renderer& renderer)
+{
+	assert(vertices.empty() && "End() was not called for the previous batch");
+
+	this->renderer = &renderer;
+	currentTexture = nullptr;
+	numDrawCalls = 0;
+	numTextureSwitches = 0;
+}
+
+void SpriteBatch::End()
+{
+	Flush();
+	renderer = nullptr;
+}
+
+void SpriteBatch::Draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect, const double rotation,
+					   const SDL_RendererFlip flip, const int zIndex, const SDL_Color color)
+{
+	assert(renderer && "Draw() called outside of Begin() / End()");
+
+	if (!texture) {
+		return;
+	}
+
+	if (texture != currentTexture || zIndex != currentZIndex) {
+		Flush();
+
+		if (texture != currentTexture) {
+			++numTextureSwitches;
+		}
+
+		int textureWidth = 1;
+		int textureHeight = 1;
+		SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+
+		currentTexture = texture;
+		currentZIndex = zIndex;
+		inverseTextureWidth = 1.0f / textureWidth;
+		inverseTextureHeight = 1.0f / textureHeight;
+	}
+
+	float u0 = srcRect.x * inverseTextureWidth;
+	float v0 = srcRect.y * inverseTextureHeight;
+	float u1 = (srcRect.x + srcRect.w) * inverseTextureWidth;
+	float v1 = (srcRect.y + srcRect.h) * inverseTextureHeight;
+
+	if (flip & SDL_FLIP_HORIZONTAL) {
+		std::swap(u0, u1);
+	}
+
+	if (flip & SDL_FLIP_VERTICAL) {
+		std::swap(v0, v1);
+	}
+
+	const glm::vec2 halfSize(destRect.w * 0.5f, destRect.h * 0.5f);
+	const glm::vec2 center(destRect.x + halfSize.x, destRect.y + halfSize.y);
+
+	// Corner offsets from the center, clockwise from the top left.
+	glm::vec2 corners[4] = {
+		glm::vec2(-halfSize.x, -halfSize.y),
+		glm::vec2(halfSize.x, -halfSize.y),
+		glm::vec2(halfSize.x, halfSize.y),
+		glm::vec2(-halfSize.x, halfSize.y),
+	};
+
+	if (rotation != 0.0) {
+		const float radians = glm::radians(static_cast<float>(rotation));
+		const float cosine = std::cos(radians);
+		const float sine = std::sin(radians);
+		for (glm::vec2& corner : corners) {
+			corner = glm::vec2(corner.x * cosine - corner.y * sine, corner.x * sine + corner.y * cosine);
+		}
+	}
+
+	const SDL_FPoint texCoords[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+	const int firstVertex = static_cast<int>(vertices.size());
+	for (int i = 0; i < 4; ++i) {
+		const SDL_FPoint position = { center.x + corners[i].x, center.y + corners[i].y };
+		vertices.push_back({ position, color, texCoords[i] });
+	}
+
+	for (const int index : { 0, 1, 2, 2, 3, 0 }) {
+		indices.push_back(firstVertex + index);
+	}
+}
+
+/**
+ * @brief Filled rect in a single color, batched with the other untextured rects.
+ */
+void SpriteBatch::DrawRect(const SDL_FRect& rect, const SDL_Color color, const int zIndex)
+{
+	assert(renderer && "DrawRect() called outside of Begin() / End()");
+
+	if (currentTexture || zIndex != currentZIndex) {
+		Flush();
+
+		if (currentTexture) {
+			++numTextureSwitches;
+		}
+
+		currentTexture = nullptr;
+		currentZIndex = zIndex;
+	}
+
+	const SDL_FPoint positions[4] = {
+		{ rect.x, rect.y },
+		{ rect.x + rect.w, rect.y },
+		{ rect.x + rect.w, rect.y + rect.h },
+		{ rect.x, rect.y + rect.h },
+	};
+
+	const int firstVertex = static_cast<int>(vertices.size());
+	for (const SDL_FPoint& position : positions) {
+		vertices.push_back({ position, color, { 0.0f, 0.0f } });
+	}
+
+	for (const int index : { 0, 1, 2, 2, 3, 0 }) {
+		indices.push_back(firstVertex + index);
+	}
+}
+
+/**
+ * @brief Submits the buffered quads in one draw call.
+ */
+void SpriteBatch::Flush()
+{
+	if (vertices.empty()) {
+		return;
+	}
+
+	SDL_RenderGeometry(renderer, currentTexture, vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+	++numDrawCalls;
+
+	vertices.clear();
+	indices.clear();
+}
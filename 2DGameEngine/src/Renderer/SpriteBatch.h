@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+/**
+ * @brief Collects textured quads and submits them with as few SDL_RenderGeometry calls as possible.
+ *
+ * Quads are buffered until the texture or the z layer changes, or End() is called.
+ * Flip and rotation are applied to the vertices and match SDL_RenderCopyEx,
+ * i.e. rotation is in degrees, clockwise, around the center of the destination.
+ * Untextured rects are batched the same way, their color comes from the vertices.
+ */
+class SpriteBatch
+{
+public:
+	SpriteBatch();
+
+	void Begin(SDL_Renderer& renderer);
+	void End();
+
+	void Draw(SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect, const double rotation = 0.0,
+			  const SDL_RendererFlip flip = SDL_FLIP_NONE, const int zIndex = 0, const SDL_Color color = { 255, 255, 255, 255 });
+
+	void DrawRect(const SDL_FRect& rect, const SDL_Color color, const int zIndex = 0);
+
+	void Flush();
+
+	inline unsigned GetNumDrawCalls() const { return numDrawCalls; }
+	inline unsigned GetNumTextureSwitches() const { return numTextureSwitches; }
+
+private:
+	SDL_Renderer* renderer;
+
+	SDL_Texture* currentTexture;
+	int currentZIndex;
+	float inverseTextureWidth;
+	float inverseTextureHeight;
+
+	std::vector<SDL_Vertex> vertices;
+	std::vector<int> indices;
+
+	unsigned numDrawCalls;
+	unsigned numTextureSwitches;
+};
@@ -0,0 +1,84 @@
+#include "TextTextureCache.h"
+
+#include "../Logger/Logger.h"
+
+#include <functional>
+#include <assert.h>
+
+static uint32_t PackColor(const SDL_Color& color)
+{
+	return (uint32_t(color.r) << 24) | (uint32_t(color.g) << 16) | (uint32_t(color.b) << 8) | uint32_t(color.a);
+}
+
+size_t TextTextureCache::TextKeyHash::operator()(const TextKey& key) const
+{
+	size_t hash = std::hash<std::string>()(key.text);
+	hash ^= std::hash<TTF_Font*>()(key.font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= std::hash<uint32_t>()(key.color) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	return hash;
+}
+
+TextTextureCache::TextTextureCache(const size_t capacity)
+	: capacity(capacity)
+	, numRasterizations(0)
+	, emptyText{ nullptr, 0, 0 }
+{
+	assert(capacity > 0);
+}
+
+TextTextureCache::~TextTextureCache()
+{
+	Clear();
+}
+
+const TextTextureCache::CachedText& TextTextureCache::GetText(SDL_Renderer& renderer, TTF_Font* font, const std::string& text, const SDL_Color& color)
+{
+	if (!font || text.empty()) {
+		return emptyText;
+	}
+
+	TextKey key = { font, PackColor(color), text };
+
+	auto entryIt = entryPerKey.find(key);
+	if (entryIt != entryPerKey.end()) {
+		// Move to the front, iterators stay valid.
+		entries.splice(entries.begin(), entries, entryIt->second);
+		return entryIt->second->text;
+	}
+
+	SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
+	++numRasterizations;
+	if (!surface) {
+		Logger::Err("Could not render text: " + text);
+		return emptyText;
+	}
+
+	SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
+	const CachedText cachedText = { texture, surface->w, surface->h };
+	SDL_FreeSurface(surface);
+
+	if (!texture) {
+		return emptyText;
+	}
+
+	if (entries.size() >= capacity) {
+		Entry& leastRecentlyUsed = entries.back();
+		SDL_DestroyTexture(leastRecentlyUsed.text.texture);
+		entryPerKey.erase(leastRecentlyUsed.key);
+		entries.pop_back();
+	}
+
+	entries.push_front({ key, cachedText });
+	entryPerKey.emplace(std::move(key), entries.begin());
+	return entries.front().text;
+}
+
+void TextTextureCache::Clear()
+{
+	for (const Entry& entry : entries) {
+		SDL_DestroyTexture(entry.text.texture);
+	}
+
+	entries.clear();
+	entryPerKey.clear();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @brief Rendered text textures keyed by font, text and color, so unchanged labels are rasterized once.
+ *
+ * Holds at most capacity textures. When full, the least recently used one is destroyed.
+ */
+class TextTextureCache
+{
+public:
+	struct CachedText
+	{
+		SDL_Texture* texture;
+		int width;
+		int height;
+	};
+
+	TextTextureCache(const size_t capacity = 256);
+	~TextTextureCache();
+
+	TextTextureCache(const TextTextureCache&) = delete;
+	TextTextureCache& operator=(const TextTextureCache&) = delete;
+
+	/**
+	 * @return The texture of the text, rendered on a miss. Texture is null if the text could not be rendered.
+	 */
+	const CachedText& GetText(SDL_Renderer& renderer, TTF_Font* font, const std::string& text, const SDL_Color& color);
+
+	void Clear();
+
+	inline size_t GetSize() const { return entries.size(); }
+
+	// Texts rendered by SDL_ttf since the cache was created.
+	inline unsigned GetNumRasterizations() const { return numRasterizations; }
+
+private:
+	struct TextKey
+	{
+		TTF_Font* font;
+		uint32_t color;
+		std::string text;
+
+		inline bool operator==(const TextKey& other) const
+		{
+			return font == other.font && color == other.color && text == other.text;
+		}
+	};
+
+	struct TextKeyHash
+	{
+		size_t operator()(const TextKey& key) const;
+	};
+
+	struct Entry
+	{
+		TextKey key;
+		CachedText text;
+	};
+
+private:
+	size_t capacity;
+	unsigned numRasterizations;
+
+	// Most recently used first.
+	std::list<Entry> entries;
+	std::unordered_map<TextKey, std::list<Entry>::iterator, TextKeyHash> entryPerKey;
+
+	// Returned when the text cannot be rendered.
+	CachedText emptyText;
+};
@@ -0,0 +1,230 @@
+#include "TileMap.h"
+
+#include "../AssetStore/AssetStore.h"
+#include "../Logger/Logger.h"
+
+#include <cmath>
+#include <assert.h>
+
+TileMap::TileMap()
+	: origin(0.0f)
+	, tileWorldSize(0.0f)
+	, numRows(0)
+	, numColumns(0)
+	, tileSize(0)
+	, numChunksX(0)
+	, numChunksY(0)
+	, isBakingUnsupported(false)
+{
+}
+
+TileMap::~TileMap()
+{
+	DestroyChunks();
+}
+
+void TileMap::Reset(const glm::vec2& origin, const float tileWorldSize, const TileMapArray& tileIndices)
+{
+	assert(tileWorldSize > 0.0f);
+
+	DestroyChunks();
+
+	this->origin = origin;
+	this->tileWorldSize = tileWorldSize;
+
+	numRows = static_cast<int>(tileIndices.size());
+	numColumns = 0;
+	for (const std::vector<int>& row : tileIndices) {
+		numColumns = glm::max(numColumns, static_cast<int>(row.size()));
+	}
+
+	// Short rows are padded with empty tiles.
+	tiles.assign(static_cast<size_t>(numRows) * numColumns, -1);
+	for (int row = 0; row < numRows; ++row) {
+		for (int column = 0; column < static_cast<int>(tileIndices[row].size()); ++column) {
+			tiles[row * numColumns + column] = tileIndices[row][column];
+		}
+	}
+
+	numChunksX = (numColumns + CHUNK_SIZE_IN_TILES - 1) / CHUNK_SIZE_IN_TILES;
+	numChunksY = (numRows + CHUNK_SIZE_IN_TILES - 1) / CHUNK_SIZE_IN_TILES;
+	chunks.assign(static_cast<size_t>(numChunksX) * numChunksY, { nullptr, true });
+}
+
+void TileMap::Clear()
+{
+	DestroyChunks();
+
+	numRows = 0;
+	numColumns = 0;
+	tiles.clear();
+	tilesetAssetId.clear();
+	tileSize = 0;
+}
+
+/**
+ * @param tileSize Size of a tile in the tileset texture, in pixels.
+ */
+void TileMap::SetTileset(const std::string& assetId, const int tileSize)
+{
+	assert(tileSize > 0);
+
+	if (assetId == tilesetAssetId && tileSize == this->tileSize) {
+		return;
+	}
+
+	// Chunk textures are sized by the tile size, create them again.
+	if (tileSize != this->tileSize) {
+		for (Chunk& chunk : chunks) {
+			if (chunk.texture) {
+				SDL_DestroyTexture(chunk.texture);
+				chunk.texture = nullptr;
+			}
+		}
+	}
+
+	tilesetAssetId = assetId;
+	this->tileSize = tileSize;
+	MarkAllDirty();
+}
+
+void TileMap::SetTile(const int row, const int column, const int tileIndex)
+{
+	if (row < 0 || row >= numRows || column < 0 || column >= numColumns) {
+		return;
+	}
+
+	int& tile = tiles[row * numColumns + column];
+	if (tile == tileIndex) {
+		return;
+	}
+
+	tile = tileIndex;
+	chunks[(row / CHUNK_SIZE_IN_TILES) * numChunksX + (column / CHUNK_SIZE_IN_TILES)].isDirty = true;
+}
+
+int TileMap::GetTile(const int row, const int column) const
+{
+	if (row < 0 || row >= numRows || column < 0 || column >= numColumns) {
+		return -1;
+	}
+
+	return tiles[row * numColumns + column];
+}
+
+void TileMap::MarkAllDirty()
+{
+	for (Chunk& chunk : chunks) {
+		chunk.isDirty = true;
+	}
+}
+
+void TileMap::DestroyChunks()
+{
+	for (Chunk& chunk : chunks) {
+		if (chunk.texture) {
+			SDL_DestroyTexture(chunk.texture);
+		}
+	}
+
+	chunks.clear();
+	numChunksX = 0;
+	numChunksY = 0;
+}
+
+/**
+ * @brief Inclusive range of the chunks overlapping the camera, empty (min > max) when none do.
+ */
+void TileMap::GetVisibleChunkRange(const SDL_Rect& camera, glm::ivec2& outMin, glm::ivec2& outMax) const
+{
+	const float chunkWorldSize = CHUNK_SIZE_IN_TILES * tileWorldSize;
+	const glm::vec2 cameraMin = (glm::vec2(camera.x, camera.y) - origin) / chunkWorldSize;
+	const glm::vec2 cameraMax = (glm::vec2(camera.x + camera.w, camera.y + camera.h) - origin) / chunkWorldSize;
+
+	outMin = glm::max(glm::ivec2(glm::floor(cameraMin)), glm::ivec2(0));
+	outMax = glm::min(glm::ivec2(glm::floor(cameraMax)), glm::ivec2(numChunksX - 1, numChunksY - 1));
+}
+
+/**
+ * @brief Draws the tiles of the chunk into its texture, creating the texture when needed.
+ * @return @c false if render targets cannot be used, the caller should draw the tiles directly.
+ */
+bool TileMap::BakeChunk(SDL_Renderer& renderer, const AssetStore& assetStore, const int chunkX, const int chunkY, Chunk& chunk)
+{
+	if (!chunk.texture) {
+		if (!SDL_RenderTargetSupported(&renderer)) {
+			Logger::Err("Render targets are not supported, tilemap chunks are not baked.");
+			isBakingUnsupported = true;
+			return false;
+		}
+
+		const int chunkPixels = CHUNK_SIZE_IN_TILES * tileSize;
+		chunk.texture = SDL_CreateTexture(&renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkPixels, chunkPixels);
+		if (!chunk.texture) {
+			Logger::Err("Could not create a tilemap chunk texture: " + std::string(SDL_GetError()));
+			isBakingUnsupported = true;
+			return false;
+		}
+
+		// Empty tiles stay transparent.
+		SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+	}
+
+	SDL_Texture* previousTarget = SDL_GetRenderTarget(&renderer);
+	Uint8 previousR, previousG, previousB, previousA;
+	SDL_GetRenderDrawColor(&renderer, &previousR, &previousG, &previousB, &previousA);
+
+	SDL_SetRenderTarget(&renderer, chunk.texture);
+	SDL_SetRenderDrawColor(&renderer, 0, 0, 0, 0);
+	SDL_RenderClear(&renderer);
+
+	const int firstRow = chunkY * CHUNK_SIZE_IN_TILES;
+	const int firstColumn = chunkX * CHUNK_SIZE_IN_TILES;
+	const int lastRow = glm::min(firstRow + CHUNK_SIZE_IN_TILES, numRows);
+	const int lastColumn = glm::min(firstColumn + CHUNK_SIZE_IN_TILES, numColumns);
+
+	SDL_Texture* tilesetTexture = assetStore.GetTextureRegion(tilesetAssetId).texture;
+	SDL_BlendMode tilesetBlendMode;
+	SDL_GetTextureBlendMode(tilesetTexture, &tilesetBlendMode);
+
+	// Copy the texels as they are, the chunk is blended once when it is drawn.
+	SDL_SetTextureBlendMode(tilesetTexture, SDL_BLENDMODE_NONE);
+
+	for (int row = firstRow; row < lastRow; ++row) {
+		for (int column = firstColumn; column < lastColumn; ++column) {
+			const int tileIndex = tiles[row * numColumns + column];
+			if (tileIndex < 0) {
+				continue;
+			}
+
+			SDL_Texture* texture = nullptr;
+			const SDL_Rect srcRect = GetTileSrcRect(assetStore, tileIndex, texture);
+			const SDL_Rect destRect = { (column - firstColumn) * tileSize, (row - firstRow) * tileSize, tileSize, tileSize };
+			SDL_RenderCopy(&renderer, texture, &srcRect, &destRect);
+		}
+	}
+
+	SDL_SetTextureBlendMode(tilesetTexture, tilesetBlendMode);
+
+	SDL_SetRenderTarget(&renderer, previousTarget);
+	SDL_SetRenderDrawColor(&renderer, previousR, previousG, previousB, previousA);
+
+	chunk.isDirty = false;
+	return true;
+}
+
+SDL_Rect TileMap::GetTileSrcRect(const AssetStore& assetStore, const int tileIndex, SDL_Texture*& outTexture) const
+{
+	const TextureRegion& tilesetRegion = assetStore.GetTextureRegion(tilesetAssetId);
+	outTexture = tilesetRegion.texture;
+
+	const int numTilesInTextureRow = glm::max(tilesetRegion.rect.w / tileSize, 1);
+	const int column = tileIndex % numTilesInTextureRow;
+	const int row = tileIndex / numTilesInTextureRow;
+	return { tilesetRegion.rect.x + column * tileSize, tilesetRegion.rect.y + row * tileSize, tileSize, tileSize };
+}
+
+SDL_FRect TileMap::GetScreenRect(const glm::vec2& worldPos, const float size, const SDL_Rect& camera) const
+{
+	return { worldPos.x - camera.x, worldPos.y - camera.y, size, size };
+}
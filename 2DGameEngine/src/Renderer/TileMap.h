@@ -0,0 +1,131 @@
+#pragma once
+
+#include <SDL.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+class AssetStore;
+
+/**
+ * @brief Static tile layer drawn as pre-baked chunk textures.
+ *
+ * The map is split into chunks of CHUNK_SIZE_IN_TILES x CHUNK_SIZE_IN_TILES tiles.
+ * Every chunk is baked into its own render target texture the first time it is
+ * visible, and baked again only after one of its tiles changed. Drawing the map
+ * is then one textured quad per visible chunk.
+ *
+ * Without render target support the visible tiles are handed out one by one instead.
+ */
+class TileMap
+{
+public:
+	using TileMapArray = std::vector<std::vector<int>>;
+
+	static const int CHUNK_SIZE_IN_TILES = 16;
+
+	TileMap();
+	~TileMap();
+
+	TileMap(const TileMap&) = delete;
+	TileMap& operator=(const TileMap&) = delete;
+
+	/**
+	 * @param tileIndices Tileset index per tile, indexed as [row][column]. Negative indices are empty tiles.
+	 * @param tileWorldSize Size of a tile in world units, the tileset size times the map scale.
+	 */
+	void Reset(const glm::vec2& origin, const float tileWorldSize, const TileMapArray& tileIndices);
+	void Clear();
+
+	void SetTileset(const std::string& assetId, const int tileSize);
+	void SetTile(const int row, const int column, const int tileIndex);
+	int GetTile(const int row, const int column) const;
+
+	/**
+	 * @brief Forces all chunks to be baked again, e.g. after SDL_RENDER_TARGETS_RESET dropped their content.
+	 */
+	void MarkAllDirty();
+
+	/**
+	 * @brief Calls callback(texture, srcRect, destRect) for every chunk overlapping the camera, in screen space.
+	 * Dirty chunks are baked first.
+	 */
+	template<typename TCallback>
+	void ForEachVisibleChunk(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, TCallback&& callback);
+
+	inline const std::string& GetTilesetAssetId() const { return tilesetAssetId; }
+	inline bool IsEmpty() const { return numRows == 0 || numColumns == 0 || tilesetAssetId.empty(); }
+
+private:
+	struct Chunk
+	{
+		SDL_Texture* texture;
+		bool isDirty;
+	};
+
+	void DestroyChunks();
+	void GetVisibleChunkRange(const SDL_Rect& camera, glm::ivec2& outMin, glm::ivec2& outMax) const;
+	bool BakeChunk(SDL_Renderer& renderer, const AssetStore& assetStore, const int chunkX, const int chunkY, Chunk& chunk);
+	SDL_Rect GetTileSrcRect(const AssetStore& assetStore, const int tileIndex, SDL_Texture*& outTexture) const;
+	SDL_FRect GetScreenRect(const glm::vec2& worldPos, const float size, const SDL_Rect& camera) const;
+
+private:
+	glm::vec2 origin;
+	float tileWorldSize;
+	int numRows;
+	int numColumns;
+	std::vector<int> tiles;
+
+	std::string tilesetAssetId;
+	int tileSize;
+
+	int numChunksX;
+	int numChunksY;
+	std::vector<Chunk> chunks;
+
+	// Set when a render target could not be used, the tiles are then drawn directly.
+	bool isBakingUnsupported;
+};
+
+
+template<typename TCallback>
+inline void TileMap::ForEachVisibleChunk(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, TCallback&& callback)
+{
+	if (IsEmpty()) {
+		return;
+	}
+
+	glm::ivec2 minChunk, maxChunk;
+	GetVisibleChunkRange(camera, minChunk, maxChunk);
+
+	for (int chunkY = minChunk.y; chunkY <= maxChunk.y; ++chunkY) {
+		for (int chunkX = minChunk.x; chunkX <= maxChunk.x; ++chunkX) {
+			Chunk& chunk = chunks[chunkY * numChunksX + chunkX];
+			const glm::ivec2 firstTile(chunkX * CHUNK_SIZE_IN_TILES, chunkY * CHUNK_SIZE_IN_TILES);
+
+			if (!isBakingUnsupported && (!chunk.isDirty || BakeChunk(renderer, assetStore, chunkX, chunkY, chunk))) {
+				const int chunkPixels = CHUNK_SIZE_IN_TILES * tileSize;
+				const SDL_Rect srcRect = { 0, 0, chunkPixels, chunkPixels };
+				const glm::vec2 chunkPos = origin + glm::vec2(firstTile) * tileWorldSize;
+				callback(chunk.texture, srcRect, GetScreenRect(chunkPos, CHUNK_SIZE_IN_TILES * tileWorldSize, camera));
+				continue;
+			}
+
+			const int lastRow = glm::min(firstTile.y + CHUNK_SIZE_IN_TILES, numRows);
+			const int lastColumn = glm::min(firstTile.x + CHUNK_SIZE_IN_TILES, numColumns);
+			for (int row = firstTile.y; row < lastRow; ++row) {
+				for (int column = firstTile.x; column < lastColumn; ++column) {
+					const int tileIndex = tiles[row * numColumns + column];
+					if (tileIndex < 0) {
+						continue;
+					}
+
+					SDL_Texture* texture = nullptr;
+					const SDL_Rect srcRect = GetTileSrcRect(assetStore, tileIndex, texture);
+					const glm::vec2 tilePos = origin + glm::vec2(column, row) * tileWorldSize;
+					callback(texture, srcRect, GetScreenRect(tilePos, tileWorldSize, camera));
+				}
+			}
+		}
+	}
+}
@@ -2,43 +2,596 @@
 
 #include "../Components/BoxColliderComponent.h"
 #include "../Components/TransformComponent.h"
+#include "../Components/RigidBodyComponent.h"
+#include "../Components/ScriptComponent.h"
 
 #include "../EventBus/EventBus.h"
-#include "../Events/CollisionEvent.h"
+#include "../Events/TileCollisionEvent.h"
+
+#include "../Math/Intersection.h"
 
 #include "../Logger/Logger.h"
 
+#include <algorithm>
+
+// Static colliders never move, so their boxes do not need any slack.
+// Swept proxies are inserted with their swept box, which the fat margin also covers.
+const float DynamicTreeFatMargin = 4.0f;
+const float StaticTreeFatMargin = 0.0f;
+
+// Below this many candidates waking the workers costs more than the tests.
+const size_t ParallelNarrowphaseMinPairs = 2048;
+const size_t NarrowphaseChunksPerThread = 4;
+
 CollisionSystem::CollisionSystem()
+	: dynamicColliders(DynamicTreeFatMargin)
+	, staticColliders(StaticTreeFatMargin)
+	, staticFiltersDirty(false)
+	, updateCount(0)
 {
 	RequireComponent<BoxColliderComponent>();
 	RequireComponent<TransformComponent>();
+
+	// Pairs that no handler is interested in.
+	collisionMatrix.SetCollides(CollisionLayer::LAYER_projectile, CollisionLayer::LAYER_projectile, false);
+	collisionMatrix.SetCollides(CollisionLayer::LAYER_tile, CollisionLayer::LAYER_tile, false);
+	collisionMatrix.SetCollides(CollisionLayer::LAYER_obstacle, CollisionLayer::LAYER_obstacle, false);
+	collisionMatrix.SetCollides(CollisionLayer::LAYER_obstacle, CollisionLayer::LAYER_tile, false);
+}
+
+void CollisionSystem::AddEntityToSystem(const Entity entity)
+{
+	System::AddEntityToSystem(entity);
+
+	if (proxyLocationPerEntity.find(entity.GetId()) != proxyLocationPerEntity.end()) {
+		// Already baked at level load.
+		return;
+	}
+
+	AddProxy(IsStaticCollider(entity), ColliderProxy(entity, GetEntityCollider(entity)));
+}
+
+void CollisionSystem::RemoveEntityFromSystem(const Entity entity)
+{
+	System::RemoveEntityFromSystem(entity);
+
+	// Its contacts are dropped on the next update, without exit events. The id may be reused by then.
+	removedEntityIds.push_back(entity.GetId());
+
+	auto locationIt = proxyLocationPerEntity.find(entity.GetId());
+	if (locationIt == proxyLocationPerEntity.end()) {
+		return;
+	}
+
+	ColliderPartition& partition = locationIt->second.isStatic ? staticColliders : dynamicColliders;
+	std::vector<ColliderProxy>& proxies = partition.proxies;
+
+	// Swap the last proxy into the freed slot to keep the array packed.
+	const size_t indexOfRemoved = locationIt->second.index;
+	const size_t indexOfLast = proxies.size() - 1;
+	partition.tree.DestroyProxy(proxies[indexOfRemoved].treeProxyId);
+
+	if (indexOfRemoved != indexOfLast) {
+		proxies[indexOfRemoved] = proxies[indexOfLast];
+		partition.tree.SetUserData(proxies[indexOfRemoved].treeProxyId, static_cast<unsigned>(indexOfRemoved));
+		proxyLocationPerEntity[proxies[indexOfRemoved].entity.GetId()].index = indexOfRemoved;
+	}
+
+	proxies.pop_back();
+	proxyLocationPerEntity.erase(locationIt);
+}
+
+/**
+ * @brief Builds the static collider tree in one go.
+ *
+ * Called by the level loader with the static colliders it created, before they
+ * are added to the system. Later additions of these entities are skipped.
+ */
+void CollisionSystem::BakeStaticColliders(const std::vector<Entity>& staticEntities)
+{
+	std::vector<ColliderProxy>& proxies = staticColliders.proxies;
+	proxies.reserve(proxies.size() + staticEntities.size());
+
+	for (const Entity entity : staticEntities) {
+		assert(IsStaticCollider(entity));
+		if (proxyLocationPerEntity.find(entity.GetId()) != proxyLocationPerEntity.end()) {
+			continue;
+		}
+
+		ColliderProxy proxy(entity, GetEntityCollider(entity));
+		UpdateProxyFilter(proxy);
+
+		proxyLocationPerEntity[entity.GetId()] = { true, proxies.size() };
+		proxies.push_back(proxy);
+	}
+
+	std::vector<Aabb> aabbs;
+	std::vector<unsigned> proxyIndices;
+	aabbs.reserve(proxies.size());
+	proxyIndices.reserve(proxies.size());
+	for (size_t i = 0; i < proxies.size(); ++i) {
+		aabbs.push_back(proxies[i].aabb);
+		proxyIndices.push_back(static_cast<unsigned>(i));
+	}
+
+	std::vector<int> treeProxyIds;
+	staticColliders.tree.Build(aabbs, proxyIndices, treeProxyIds);
+	for (size_t i = 0; i < proxies.size(); ++i) {
+		proxies[i].treeProxyId = treeProxyIds[i];
+	}
+
+	Logger::Log("Baked " + std::to_string(proxies.size()) + " static colliders, tree height: " + std::to_string(staticColliders.tree.GetHeight()));
 }
 
 void CollisionSystem::Update(EventBus& eventBus)
 {
-	std::vector<Entity>& entities(GetSystemEntities());
+	UpdateDynamicProxies();
+
+	if (staticFiltersDirty) {
+		for (ColliderProxy& proxy : staticColliders.proxies) {
+			UpdateProxyFilter(proxy);
+		}
+		staticFiltersDirty = false;
+	}
 
-	for (auto it = entities.begin(); it != entities.end(); ++it) {
-		const Entity& entity(*it);
-		const Aabb aabb(GetEntityAabb(entity));
+	FindCandidatePairs();
+	FindOverlappingPairs();
+	UpdateContacts();
+	UpdateTileContacts(eventBus);
 
-		for (auto itOther = it + 1; itOther != entities.end(); ++itOther) {
-			const Entity& entityOther(*itOther);
+	if (eventBus.HasSubscribers<CollisionBatchEvent>()) {
+		eventBus.EmitEvents<CollisionBatchEvent>(enteredContacts, stayingContacts, exitedContacts);
+	}
+
+	if (eventBus.HasSubscribers<CollisionEnterEvent>()) {
+		for (const CollisionPair& pair : enteredContacts) {
+			eventBus.EmitEvents<CollisionEnterEvent>(pair.a, pair.b);
+		}
+	}
+
+	if (eventBus.HasSubscribers<CollisionStayEvent>()) {
+		for (const CollisionPair& pair : stayingContacts) {
+			eventBus.EmitEvents<CollisionStayEvent>(pair.a, pair.b);
+		}
+	}
+
+	if (eventBus.HasSubscribers<CollisionExitEvent>()) {
+		for (const CollisionPair& pair : exitedContacts) {
+			eventBus.EmitEvents<CollisionExitEvent>(pair.a, pair.b);
+		}
+	}
+}
+
+std::vector<Entity> CollisionSystem::QueryAabb(const Aabb& aabb, const CollisionMask layerMask) const
+{
+	WorldCollider queryCollider;
+	queryCollider.box = Obb((aabb.min + aabb.max) * 0.5f, (aabb.max - aabb.min) * 0.5f, 0.0f);
 
-			const Aabb aabbOther(GetEntityAabb(entityOther));
-			if (aabb.Overlaps(aabbOther)) {
-				eventBus.EmitEvents<CollisionEvent>(CollisionEvent(entity, entityOther));
+	std::vector<Entity> result;
+	ForEachProxy(aabb, [&](const ColliderProxy& proxy) {
+		if ((proxy.layerBit & layerMask) && proxy.aabb.Overlaps(aabb) && CollidersOverlap(proxy.collider, queryCollider)) {
+			result.push_back(proxy.entity);
+		}
+	});
+
+	return result;
+}
+
+std::vector<Entity> CollisionSystem::QueryPoint(const glm::vec2& point, const CollisionMask layerMask) const
+{
+	WorldCollider queryCollider;
+	queryCollider.shape = ColliderShape::SHAPE_circle;
+	queryCollider.circle = Circle(point, 0.0f);
+	queryCollider.isAxisAligned = false;
+
+	std::vector<Entity> result;
+	ForEachProxy(Aabb(point, point), [&](const ColliderProxy& proxy) {
+		if ((proxy.layerBit & layerMask) && proxy.aabb.Contains(point) && CollidersOverlap(proxy.collider, queryCollider)) {
+			result.push_back(proxy.entity);
+		}
+	});
+
+	return result;
+}
+
+/**
+ * @brief Finds the first collider hit by the segment. Rotated boxes and circles are hit at their bounds.
+ * @return @c true if something was hit, @c outHit is filled in that case.
+ */
+bool CollisionSystem::Raycast(const glm::vec2& from, const glm::vec2& to, RaycastHit& outHit, const CollisionMask layerMask) const
+{
+	bool hasHit = false;
+	float closestFraction = 1.0f;
+
+	for (const ColliderPartition* partition : { &dynamicColliders, &staticColliders }) {
+		partition->tree.Raycast(from, to, [&](const int treeProxyId, const float maxFraction) {
+			const ColliderProxy& proxy = partition->proxies[partition->tree.GetUserData(treeProxyId)];
+			if (!(proxy.layerBit & layerMask)) {
+				return maxFraction;
+			}
+
+			float fraction = 0.0f;
+			if (!findIntersection(fraction, from, to, proxy.aabb) || fraction >= maxFraction || fraction > closestFraction) {
+				return maxFraction;
+			}
+
+			hasHit = true;
+			closestFraction = fraction;
+			outHit.entity = proxy.entity;
+			outHit.fraction = fraction;
+			outHit.point = from + (to - from) * fraction;
+			return fraction;
+		});
+	}
+
+	return hasHit;
+}
+
+/**
+ * @brief Whether the entity overlapped another collider in the last update.
+ */
+bool CollisionSystem::IsColliding(const Entity entity) const
+{
+	const unsigned entityId = entity.GetId();
+	return (updateCount != 0) && (entityId < lastCollisionUpdatePerEntity.size()) && (lastCollisionUpdatePerEntity[entityId] == updateCount);
+}
+
+void CollisionSystem::SetLayersCollide(const CollisionLayer a, const CollisionLayer b, const bool collides)
+{
+	collisionMatrix.SetCollides(a, b, collides);
+
+	// Dynamic filters are refreshed every update anyway.
+	staticFiltersDirty = true;
+}
+
+/**
+ * @brief Colliders without a rigidbody or a script are treated as static. Scripts can move
+ * their entity through set_position and set_rotation, same as for the RenderSystem's static sprites.
+ */
+bool CollisionSystem::IsStaticCollider(const Entity entity)
+{
+	return !entity.HasComponent<RigidBodyComponent>()
+		&& !entity.HasComponent<ScriptComponent>();
+}
+
+void CollisionSystem::AddProxy(const bool isStatic, ColliderProxy proxy)
+{
+	ColliderPartition& partition = isStatic ? staticColliders : dynamicColliders;
+	const size_t proxyIndex = partition.proxies.size();
+
+	UpdateProxyFilter(proxy);
+	proxy.treeProxyId = partition.tree.CreateProxy(proxy.aabb, static_cast<unsigned>(proxyIndex));
+
+	partition.proxies.push_back(proxy);
+	proxyLocationPerEntity[proxy.entity.GetId()] = { isStatic, proxyIndex };
+}
+
+void CollisionSystem::UpdateDynamicProxies()
+{
+	for (ColliderProxy& proxy : dynamicColliders.proxies) {
+		proxy.collider = GetEntityCollider(proxy.entity);
+		proxy.aabb = proxy.collider.GetAabb();
+		proxy.displacement = glm::vec2(0.0f);
+
+		// Scripted colliders can be dynamic without a rigidbody, they are not swept.
+		if (proxy.entity.HasComponent<RigidBodyComponent>()) {
+			const RigidBodyComponent& rigidbody = proxy.entity.GetComponent<RigidBodyComponent>();
+			if (rigidbody.continuousCollision) {
+				proxy.displacement = rigidbody.lastDisplacement;
 			}
 		}
+
+		dynamicColliders.tree.MoveProxy(proxy.treeProxyId, proxy.GetSweptAabb());
+		UpdateProxyFilter(proxy);
 	}
 }
 
-Aabb GetEntityAabb(const Entity& entity)
+/**
+ * @brief Broadphase, only dynamic proxies query. Dynamic pairs are reported by their lower index only,
+ * static proxies never test against each other.
+ */
+void CollisionSystem::FindCandidatePairs()
+{
+	candidatePairs.clear();
+	candidateAabbsA.Clear();
+	candidateAabbsB.Clear();
+
+	const std::vector<ColliderProxy>& dynamicProxies = dynamicColliders.proxies;
+	const std::vector<ColliderProxy>& staticProxies = staticColliders.proxies;
+
+	for (size_t i = 0; i < dynamicProxies.size(); ++i) {
+		const ColliderProxy& proxy = dynamicProxies[i];
+		if (proxy.collisionMask == 0) {
+			continue;
+		}
+
+		const Aabb queryAabb = proxy.GetSweptAabb();
+
+		dynamicColliders.tree.QueryAabb(queryAabb, [&](const int treeProxyId) {
+			const size_t j = dynamicColliders.tree.GetUserData(treeProxyId);
+			const ColliderProxy& other = dynamicProxies[j];
+			if (j > i && proxy.ShouldCollide(other)) {
+				candidatePairs.push_back({ &proxy, &other });
+				candidateAabbsA.Add(proxy.aabb);
+				candidateAabbsB.Add(other.aabb);
+			}
+
+			return true;
+		});
+
+		staticColliders.tree.QueryAabb(queryAabb, [&](const int treeProxyId) {
+			const ColliderProxy& other = staticProxies[staticColliders.tree.GetUserData(treeProxyId)];
+			if (proxy.ShouldCollide(other)) {
+				candidatePairs.push_back({ &proxy, &other });
+				candidateAabbsA.Add(proxy.aabb);
+				candidateAabbsB.Add(other.aabb);
+			}
+
+			return true;
+		});
+	}
+}
+
+/**
+ * @brief Narrowphase, tests the candidates in contiguous chunks.
+ *
+ * The boxes of the pairs are compared in SIMD batches, only the misses of swept pairs
+ * fall back to the scalar sweep test.
+ *
+ * Only reads the proxies, never the registry, so the chunks can run on any thread.
+ * Each chunk writes its own buffer and the buffers are appended in chunk order.
+ */
+void CollisionSystem::FindOverlappingPairs()
+{
+	overlappingPairs.clear();
+
+	const size_t numCandidates = candidatePairs.size();
+	const size_t numChunks = (numCandidates < ParallelNarrowphaseMinPairs) ? 1 : workerPool.GetThreadCount() * NarrowphaseChunksPerThread;
+	const size_t numBatches = (numCandidates + AABB_BATCH_WIDTH - 1) / AABB_BATCH_WIDTH;
+	const size_t chunkSize = (numBatches + numChunks - 1) / numChunks * AABB_BATCH_WIDTH;
+
+	if (overlappingPairsPerChunk.size() < numChunks) {
+		overlappingPairsPerChunk.resize(numChunks);
+	}
+
+	workerPool.Run(numChunks, [&](const size_t chunkIndex) {
+		std::vector<CollisionPair>& chunkPairs = overlappingPairsPerChunk[chunkIndex];
+		chunkPairs.clear();
+
+		const size_t begin = std::min(chunkIndex * chunkSize, numCandidates);
+		const size_t end = std::min(begin + chunkSize, numCandidates);
+		for (size_t first = begin; first < end; first += AABB_BATCH_WIDTH) {
+			const unsigned hitMask = candidateAabbsA.PairwiseOverlapMask(candidateAabbsB, first);
+			const size_t numLanes = std::min(AABB_BATCH_WIDTH, end - first);
+
+			for (size_t lane = 0; lane < numLanes; ++lane) {
+				const CandidatePair& candidate = candidatePairs[first + lane];
+				if (TestOverlap(*candidate.a, *candidate.b, (hitMask >> lane) & 1)) {
+					chunkPairs.emplace_back(candidate.a->entity, candidate.b->entity);
+				}
+			}
+		}
+	});
+
+	for (size_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+		const std::vector<CollisionPair>& chunkPairs = overlappingPairsPerChunk[chunkIndex];
+		overlappingPairs.insert(overlappingPairs.end(), chunkPairs.begin(), chunkPairs.end());
+	}
+}
+
+/**
+ * @brief Tests the exact shapes if the bounds overlap, else sweeps the bounds against each other
+ * if either one moves continuously.
+ */
+bool CollisionSystem::TestOverlap(const ColliderProxy& a, const ColliderProxy& b, const bool boundsOverlap)
+{
+	if (boundsOverlap) {
+		return CollidersOverlap(a.collider, b.collider);
+	}
+
+	return TestSweep(a, b);
+}
+
+/**
+ * @brief Moves a relative to b, and casts the min corner of a against b grown by the size of a.
+ */
+bool CollisionSystem::TestSweep(const ColliderProxy& a, const ColliderProxy& b)
+{
+	const glm::vec2 relativeDisplacement = a.displacement - b.displacement;
+	if (relativeDisplacement == glm::vec2(0.0f)) {
+		return false;
+	}
+
+	const glm::vec2 sizeOfA(a.aabb.GetWidth(), a.aabb.GetHeight());
+	const Aabb expandedB(b.aabb.min - sizeOfA, b.aabb.max);
+
+	float fraction = 0.0f;
+	return findIntersection(fraction, a.aabb.min - relativeDisplacement, a.aabb.min, expandedB);
+}
+
+/**
+ * @brief Caches the layer bit and the effective mask (matrix row & collider mask) of the proxy.
+ */
+void CollisionSystem::UpdateProxyFilter(ColliderProxy& proxy) const
+{
+	const BoxColliderComponent& collider = proxy.entity.GetComponent<BoxColliderComponent>();
+	proxy.layerBit = CollisionMatrix::GetLayerBit(collider.layer);
+	proxy.collisionMask = collisionMatrix.GetMask(collider.layer) & collider.mask;
+}
+
+/**
+ * @brief Matches this update's overlapping pairs against the remembered contacts
+ * and sorts them into entered, staying and exited ones.
+ */
+void CollisionSystem::UpdateContacts()
+{
+	++updateCount;
+
+	PurgeContactsOfRemovedEntities();
+
+	enteredContacts.clear();
+	stayingContacts.clear();
+	exitedContacts.clear();
+
+	for (const CollisionPair& pair : overlappingPairs) {
+		for (const Entity entity : { pair.a, pair.b }) {
+			if (entity.GetId() >= lastCollisionUpdatePerEntity.size()) {
+				lastCollisionUpdatePerEntity.resize(entity.GetId() + 1, 0);
+			}
+
+			lastCollisionUpdatePerEntity[entity.GetId()] = updateCount;
+		}
+
+		auto result = contacts.emplace(GetContactKey(pair.a, pair.b), Contact{ pair, updateCount });
+		if (result.second) {
+			enteredContacts.push_back(pair);
+			continue;
+		}
+
+		Contact& contact = result.first->second;
+		contact.lastUpdate = updateCount;
+		stayingContacts.push_back(contact.pair);
+	}
+
+	std::vector<uint64_t> exitedKeys;
+	for (const auto& keyAndContact : contacts) {
+		if (keyAndContact.second.lastUpdate != updateCount) {
+			exitedKeys.push_back(keyAndContact.first);
+		}
+	}
+
+	// Hash map order is not stable, keep the exit events in a reproducible order.
+	std::sort(exitedKeys.begin(), exitedKeys.end());
+	for (const uint64_t key : exitedKeys) {
+		auto contactIt = contacts.find(key);
+		exitedContacts.push_back(contactIt->second.pair);
+		contacts.erase(contactIt);
+	}
+}
+
+/**
+ * @brief Tests the dynamic proxies against the solid tiles and reports the ones that touch them or stopped touching them.
+ *
+ * Swept proxies test their swept box, which is conservative for diagonal movement.
+ */
+void CollisionSystem::UpdateTileContacts(EventBus& eventBus)
+{
+	if (tileCollisionGrid.IsEmpty()) {
+		return;
+	}
+
+	const CollisionMask tileLayerBit = CollisionMatrix::GetLayerBit(CollisionLayer::LAYER_tile);
+	const CollisionMask tileMask = collisionMatrix.GetMask(CollisionLayer::LAYER_tile);
+	const bool hasSubscribers = eventBus.HasSubscribers<TileCollisionEvent>();
+
+	for (const ColliderProxy& proxy : dynamicColliders.proxies) {
+		if (!(proxy.collisionMask & tileLayerBit) || !(tileMask & proxy.layerBit)) {
+			continue;
+		}
+
+		const unsigned entityId = proxy.entity.GetId();
+		if (entityId >= lastTileContactUpdatePerEntity.size()) {
+			lastTileContactUpdatePerEntity.resize(entityId + 1, 0);
+		}
+
+		unsigned& lastTileContactUpdate = lastTileContactUpdatePerEntity[entityId];
+		const bool wasTouching = (lastTileContactUpdate != 0) && (lastTileContactUpdate == updateCount - 1);
+		const bool isTouching = tileCollisionGrid.Overlaps(proxy.GetSweptAabb());
+
+		if (isTouching) {
+			lastTileContactUpdate = updateCount;
+		}
+
+		if ((isTouching || wasTouching) && hasSubscribers) {
+			const glm::vec2 penetration = isTouching ? tileCollisionGrid.GetPenetration(proxy.aabb) : glm::vec2(0.0f);
+			eventBus.EmitEvents<TileCollisionEvent>(proxy.entity, isTouching, wasTouching, penetration);
+		}
+	}
+}
+
+void CollisionSystem::PurgeContactsOfRemovedEntities()
+{
+	if (removedEntityIds.empty()) {
+		return;
+	}
+
+	for (const unsigned entityId : removedEntityIds) {
+		if (entityId < lastTileContactUpdatePerEntity.size()) {
+			lastTileContactUpdatePerEntity[entityId] = 0;
+		}
+	}
+
+	std::sort(removedEntityIds.begin(), removedEntityIds.end());
+	auto isRemoved = [this](const Entity entity) {
+		return std::binary_search(removedEntityIds.begin(), removedEntityIds.end(), entity.GetId());
+	};
+
+	for (auto contactIt = contacts.begin(); contactIt != contacts.end();) {
+		if (isRemoved(contactIt->second.pair.a) || isRemoved(contactIt->second.pair.b)) {
+			contactIt = contacts.erase(contactIt);
+		}
+		else {
+			++contactIt;
+		}
+	}
+
+	removedEntityIds.clear();
+}
+
+Aabb WorldCollider::GetAabb() const
+{
+	return (shape == ColliderShape::SHAPE_circle) ? circle.GetAabb() : box.GetAabb();
+}
+
+WorldCollider GetEntityCollider(const Entity& entity)
 {
 	const TransformComponent& transform = entity.GetComponent<TransformComponent>();
 	const BoxColliderComponent& collider = entity.GetComponent<BoxColliderComponent>();
 
-	const glm::vec2 minPos = transform.position + collider.offset;
-	const glm::vec2 maxPos = minPos + glm::vec2(collider.width, collider.height) + collider.offset;
-	return Aabb(minPos, maxPos);
+	const glm::vec2 scale = glm::abs(transform.scale);
+	const glm::vec2 halfSize = glm::vec2(collider.width, collider.height) * scale * 0.5f;
+	const glm::vec2 center = transform.position + collider.offset * scale + halfSize;
+
+	WorldCollider worldCollider;
+	worldCollider.shape = collider.shape;
+
+	if (collider.shape == ColliderShape::SHAPE_circle) {
+		worldCollider.circle = Circle(center, glm::min(halfSize.x, halfSize.y));
+		worldCollider.isAxisAligned = false;
+	}
+	else {
+		worldCollider.box = Obb(center, halfSize, glm::radians(static_cast<float>(transform.rotation)));
+		worldCollider.isAxisAligned = (transform.rotation == 0.0);
+	}
+
+	return worldCollider;
+}
+
+Aabb GetEntityAabb(const Entity& entity)
+{
+	return GetEntityCollider(entity).GetAabb();
+}
+
+bool CollidersOverlap(const WorldCollider& a, const WorldCollider& b)
+{
+	if (a.isAxisAligned && b.isAxisAligned) {
+		return a.GetAabb().Overlaps(b.GetAabb());
+	}
+
+	const bool isCircleA = (a.shape == ColliderShape::SHAPE_circle);
+	const bool isCircleB = (b.shape == ColliderShape::SHAPE_circle);
+
+	if (isCircleA && isCircleB) {
+		return testOverlap(a.circle, b.circle);
+	}
+
+	if (isCircleA) {
+		return testOverlap(a.circle, b.box);
+	}
+
+	if (isCircleB) {
+		return testOverlap(b.circle, a.box);
+	}
+
+	return testOverlap(a.box, b.box);
 }
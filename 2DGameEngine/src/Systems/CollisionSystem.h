@@ -2,16 +2,254 @@
 
 #include "../ECS/ECS.h"
 #include "../Utilities/Geometry.h"
+#include "../Utilities/AabbTree.h"
+#include "../Utilities/AabbBatch.h"
+#include "../Utilities/CollisionMatrix.h"
+#include "../Utilities/WorkerPool.h"
+#include "../Utilities/TileCollisionGrid.h"
+#include "../Events/CollisionEvent.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
 
 class EventBus;
 
+/**
+ * @brief Collider of an entity in world space, with the scale and rotation of its transform applied.
+ *
+ * Rotation is around the center of the collider box. For colliders that match
+ * their sprite this is the pivot SDL_RenderCopyEx rotates the sprite around.
+ */
+struct WorldCollider
+{
+	WorldCollider()
+		: shape(ColliderShape::SHAPE_box)
+		, isAxisAligned(true)
+	{
+	}
+
+	Aabb GetAabb() const;
+
+	ColliderShape shape;
+	Obb box;
+	Circle circle;
+
+	// Axis aligned boxes are exactly their bound, no narrowphase test needed.
+	bool isAxisAligned;
+};
+
+WorldCollider GetEntityCollider(const Entity& entity);
 Aabb GetEntityAabb(const Entity& entity);
+bool CollidersOverlap(const WorldCollider& a, const WorldCollider& b);
+
+struct RaycastHit
+{
+	RaycastHit()
+		: entity(INVALID_ENTITY_ID)
+		, point(0.0f)
+		, fraction(1.0f)
+	{
+	}
+
+	Entity entity;
+	glm::vec2 point;
+	float fraction;
+};
 
+/**
+ * @brief Detects overlapping colliders and answers spatial queries.
+ *
+ * Colliders without a rigidbody or script are static: they are assumed to never move and
+ * live in their own tree which is baked once at level load. Dynamic colliders
+ * are kept in a tree that is refitted every update. Only dynamic-vs-dynamic and
+ * dynamic-vs-static pairs are tested.
+ *
+ * The broadphase runs on the calling thread and collects candidate pairs, large
+ * candidate sets are tested on worker threads, AABB_BATCH_WIDTH pairs at a time. Results are merged in candidate
+ * order, so the pairs and events are the same for any number of threads.
+ *
+ * Boxes and circles are bounded by an AABB in the broadphase and the SIMD pass,
+ * rotated boxes and circles are then tested exactly.
+ *
+ * Dynamic colliders whose layers collide with LAYER_tile are also tested against
+ * the tile collision grid. A TileCollisionEvent is emitted every update they touch
+ * solid tiles, with the translation out of them, and once when they stop touching.
+ *
+ * Rigidbodies flagged for continuous collision are swept along the movement of
+ * their last update, so fast ones still hit colliders thinner than their step.
+ *
+ * Queries run against the boxes of the last update.
+ * Pairs whose layers do not collide according to the collision matrix are
+ * rejected before any box test.
+ *
+ * Overlapping pairs are remembered between updates, so each contact is reported
+ * once with an enter event, every following update with a stay event and once
+ * more with an exit event when the colliders separate. All of them are also
+ * emitted together in one batch event. Per pair events are only built when
+ * something subscribed to them.
+ */
 class CollisionSystem : public System
 {
 public:
 	CollisionSystem();
 
+	virtual void AddEntityToSystem(const Entity entity) override;
+	virtual void RemoveEntityFromSystem(const Entity entity) override;
+
+	void BakeStaticColliders(const std::vector<Entity>& staticEntities);
+
 	void Update(EventBus& eventBus);
+
+	std::vector<Entity> QueryAabb(const Aabb& aabb, const CollisionMask layerMask = COLLISION_MASK_ALL) const;
+	std::vector<Entity> QueryPoint(const glm::vec2& point, const CollisionMask layerMask = COLLISION_MASK_ALL) const;
+	bool Raycast(const glm::vec2& from, const glm::vec2& to, RaycastHit& outHit, const CollisionMask layerMask = COLLISION_MASK_ALL) const;
+
+	bool IsColliding(const Entity entity) const;
+	inline const std::vector<CollisionPair>& GetOverlappingPairs() const { return overlappingPairs; }
+
+	void SetLayersCollide(const CollisionLayer a, const CollisionLayer b, const bool collides);
+
+	inline TileCollisionGrid& GetTileCollisionGrid() { return tileCollisionGrid; }
+	inline const TileCollisionGrid& GetTileCollisionGrid() const { return tileCollisionGrid; }
+	inline const CollisionMatrix& GetCollisionMatrix() const { return collisionMatrix; }
+
+	static bool IsStaticCollider(const Entity entity);
+
+private:
+	struct ColliderProxy
+	{
+		ColliderProxy(const Entity entity, const WorldCollider& collider)
+			: entity(entity)
+			, collider(collider)
+			, aabb(collider.GetAabb())
+			, displacement(0.0f)
+			, treeProxyId(AABB_TREE_NULL_NODE)
+			, layerBit(0)
+			, collisionMask(0)
+		{
+		}
+
+		inline bool ShouldCollide(const ColliderProxy& other) const
+		{
+			return (collisionMask & other.layerBit) && (other.collisionMask & layerBit);
+		}
+
+		// Box covering the whole movement of the last update.
+		inline Aabb GetSweptAabb() const
+		{
+			return Aabb(glm::min(aabb.min, aabb.min - displacement), glm::max(aabb.max, aabb.max - displacement));
+		}
+
+		Entity entity;
+		WorldCollider collider;
+		Aabb aabb;
+		glm::vec2 displacement;
+		int treeProxyId;
+		CollisionMask layerBit;
+		CollisionMask collisionMask;
+	};
+
+	// Proxies are kept contiguous, tree leaves store their index.
+	struct ColliderPartition
+	{
+		ColliderPartition(const float fatMargin)
+			: tree(fatMargin)
+		{
+		}
+
+		AabbTree tree;
+		std::vector<ColliderProxy> proxies;
+	};
+
+	struct ProxyLocation
+	{
+		bool isStatic;
+		size_t index;
+	};
+
+	struct CandidatePair
+	{
+		const ColliderProxy* a;
+		const ColliderProxy* b;
+	};
+
+	struct Contact
+	{
+		CollisionPair pair;
+		unsigned lastUpdate;
+	};
+
+	void AddProxy(const bool isStatic, ColliderProxy proxy);
+	void UpdateDynamicProxies();
+	void UpdateProxyFilter(ColliderProxy& proxy) const;
+	void FindCandidatePairs();
+	void FindOverlappingPairs();
+	void UpdateContacts();
+	void UpdateTileContacts(EventBus& eventBus);
+
+	static bool TestOverlap(const ColliderProxy& a, const ColliderProxy& b, const bool boundsOverlap);
+	static bool TestSweep(const ColliderProxy& a, const ColliderProxy& b);
+	void PurgeContactsOfRemovedEntities();
+
+	static inline uint64_t GetContactKey(const Entity a, const Entity b);
+
+	template<typename TCallback>
+	void ForEachProxy(const Aabb& aabb, TCallback&& callback) const;
+
+private:
+	ColliderPartition dynamicColliders;
+	ColliderPartition staticColliders;
+	std::unordered_map<unsigned, ProxyLocation> proxyLocationPerEntity;
+
+	CollisionMatrix collisionMatrix;
+	bool staticFiltersDirty;
+
+	std::vector<CandidatePair> candidatePairs;
+	AabbBatch candidateAabbsA;
+	AabbBatch candidateAabbsB;
+	std::vector<CollisionPair> overlappingPairs;
+
+	WorkerPool workerPool;
+	std::vector<std::vector<CollisionPair>> overlappingPairsPerChunk;
+
+	std::unordered_map<uint64_t, Contact> contacts;
+	std::vector<unsigned> removedEntityIds;
+	unsigned updateCount;
+
+	// Update count of the last overlap per entity id, compared against updateCount so it never needs clearing.
+	std::vector<unsigned> lastCollisionUpdatePerEntity;
+
+	TileCollisionGrid tileCollisionGrid;
+	std::vector<unsigned> lastTileContactUpdatePerEntity;
+
+	std::vector<CollisionPair> enteredContacts;
+	std::vector<CollisionPair> stayingContacts;
+	std::vector<CollisionPair> exitedContacts;
 };
 
+
+/**
+ * @brief Calls callback(proxy) for every static and dynamic proxy whose tree box overlaps the given box.
+ */
+template<typename TCallback>
+inline void CollisionSystem::ForEachProxy(const Aabb& aabb, TCallback&& callback) const
+{
+	for (const ColliderPartition* partition : { &dynamicColliders, &staticColliders }) {
+		partition->tree.QueryAabb(aabb, [&](const int treeProxyId) {
+			callback(partition->proxies[partition->tree.GetUserData(treeProxyId)]);
+			return true;
+		});
+	}
+}
+
+/**
+ * @brief Order independent key of an entity pair.
+ */
+uint64_t CollisionSystem::GetContactKey(const Entity a, const Entity b)
+{
+	const uint64_t idA = static_cast<uint32_t>(a.GetId());
+	const uint64_t idB = static_cast<uint32_t>(b.GetId());
+	return (idA < idB) ? ((idA << 32) | idB) : ((idB << 32) | idA);
+}
@@ -15,28 +15,30 @@ DamageSystem::DamageSystem()
 
 void DamageSystem::SubscribeToEvents(EventBus& eventBus)
 {
-	eventBus.SubscribeToEvents(this, &DamageSystem::OnCollisionHappened);
+	eventBus.SubscribeToEvents(this, &DamageSystem::OnCollisionBatch);
 }
 
-void DamageSystem::OnCollisionHappened(CollisionEvent& event)
+void DamageSystem::OnCollisionBatch(CollisionBatchEvent& event)
 {
-	Entity a = event.a;
-	Entity b = event.b;
+	for (const CollisionPair& pair : event.entered) {
+		Entity a = pair.a;
+		Entity b = pair.b;
 
-	if (a.BelongsToGroup("projectiles") && b.HasTag("player")) {
-		OnProjectileHitsPlayer(a, b);
-	}
+		if (a.BelongsToGroup("projectiles") && b.HasTag("player")) {
+			OnProjectileHitsPlayer(a, b);
+		}
 
-	if (b.BelongsToGroup("projectiles") && a.HasTag("player")) {
-		OnProjectileHitsPlayer(b, a);
-	}
+		if (b.BelongsToGroup("projectiles") && a.HasTag("player")) {
+			OnProjectileHitsPlayer(b, a);
+		}
 
-	if (a.BelongsToGroup("projectiles") && b.BelongsToGroup("enemies")) {
-		OnProjectileHitsEnemy(a, b);
-	}
+		if (a.BelongsToGroup("projectiles") && b.BelongsToGroup("enemies")) {
+			OnProjectileHitsEnemy(a, b);
+		}
 
-	if (b.BelongsToGroup("projectiles") && a.BelongsToGroup("enemies")) {
-		OnProjectileHitsEnemy(b, a);
+		if (b.BelongsToGroup("projectiles") && a.BelongsToGroup("enemies")) {
+			OnProjectileHitsEnemy(b, a);
+		}
 	}
 }
 
@@ -14,7 +14,7 @@ public:
 
 private:
 
-	void OnCollisionHappened(CollisionEvent& event);
+	void OnCollisionBatch(CollisionBatchEvent& event);
 	void OnProjectileHitsPlayer(Entity projectile, Entity player);
 	void OnProjectileHitsEnemy(Entity projectile, Entity enemy);
 };
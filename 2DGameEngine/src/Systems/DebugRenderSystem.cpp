@@ -7,9 +7,12 @@
 
 #include <SDL.h>
 #include <algorithm>
+#include <array>
+#include <glm/gtc/constants.hpp>
 
 const Uint8 colliderColorCollision[4] = { 255, 0, 0 , 255 };
 const Uint8 colliderColorNoCollision[4] = { 0, 255, 0 , 255 };
+const int CircleSegmentCount = 16;
 
 DebugRenderSystem::DebugRenderSystem()
 	: colliderDrawingEnabled(true)
@@ -18,10 +21,10 @@ DebugRenderSystem::DebugRenderSystem()
 	RequireComponent<BoxColliderComponent>();
 }
 
-void DebugRenderSystem::Update(SDL_Renderer& renderer, const SDL_Rect& camera)
+void DebugRenderSystem::Update(SDL_Renderer& renderer, const SDL_Rect& camera, const CollisionSystem& collisionSystem, RenderStats& stats)
 {
 	if (colliderDrawingEnabled) {
-		DrawColliders(renderer, camera);
+		DrawColliders(renderer, camera, collisionSystem, stats);
 	}
 }
 
@@ -30,29 +33,44 @@ void DebugRenderSystem::HandleInput(const SDL_Event& event)
 }
 
 
-void DebugRenderSystem::DrawColliders(SDL_Renderer& renderer, const SDL_Rect& camera)
+/**
+ * @brief Draws every visible collider box, colored by the result of the last collision update.
+ */
+void DebugRenderSystem::DrawColliders(SDL_Renderer& renderer, const SDL_Rect& camera, const CollisionSystem& collisionSystem, RenderStats& stats)
 {
-	for (Entity entity : GetSystemEntities()) {
+	const std::vector<Entity>& entities = GetSystemEntities();
 
-		bool isColliding = false;
-		const Aabb aabb(GetEntityAabb(entity));
-
-		for (Entity entityOther : GetSystemEntities()) {
+	colliders.clear();
+	colliderAabbs.Clear();
+	colliderAabbs.Reserve(entities.size());
+	for (const Entity entity : entities) {
+		colliders.push_back(GetEntityCollider(entity));
+		colliderAabbs.Add(colliders.back().GetAabb());
+	}
 
-			if (entity == entityOther) {
-				continue;
-			}
+	const glm::vec2 cameraMin(camera.x, camera.y);
+	const Aabb cameraAabb(cameraMin, cameraMin + glm::vec2(camera.w, camera.h));
 
-			const Aabb aabbOther(GetEntityAabb(entityOther));
-			if (aabb.Overlaps(aabbOther)) {
-				isColliding = true;
-				break;
-			}
-		}
+	colliderAabbs.ForEachOverlap(cameraAabb, [&](const size_t index) {
+		const bool isColliding = collisionSystem.IsColliding(entities[index]);
 
 		const Uint8* collisionColor = isColliding ? colliderColorCollision : colliderColorNoCollision;
 		SDL_SetRenderDrawColor(&renderer, collisionColor[0], collisionColor[1], collisionColor[2], collisionColor[3]);
 
+		DrawCollider(renderer, camera, colliders[index]);
+		++stats.drawCalls;
+	});
+}
+
+/**
+ * @brief Draws the outline of the collider shape, circles as polygons.
+ */
+void DebugRenderSystem::DrawCollider(SDL_Renderer& renderer, const SDL_Rect& camera, const WorldCollider& collider)
+{
+	const glm::vec2 cameraPos(camera.x, camera.y);
+
+	if (collider.isAxisAligned) {
+		const Aabb aabb(collider.GetAabb());
 		SDL_Rect boxColliderRect = {
 			static_cast<int>(aabb.min.x) - camera.x,
 			static_cast<int>(aabb.min.y) - camera.y,
@@ -61,5 +79,36 @@ void DebugRenderSystem::DrawColliders(SDL_Renderer& renderer, const SDL_Rect& ca
 		};
 
 		SDL_RenderDrawRect(&renderer, &boxColliderRect);
+		return;
 	}
+
+	if (collider.shape == ColliderShape::SHAPE_circle) {
+		std::array<SDL_FPoint, CircleSegmentCount + 1> points;
+		for (int i = 0; i <= CircleSegmentCount; ++i) {
+			const float angle = glm::two_pi<float>() * i / CircleSegmentCount;
+			const glm::vec2 point = collider.circle.center + collider.circle.radius * glm::vec2(std::cos(angle), std::sin(angle)) - cameraPos;
+			points[i] = { point.x, point.y };
+		}
+
+		SDL_RenderDrawLinesF(&renderer, points.data(), static_cast<int>(points.size()));
+		return;
+	}
+
+	const Obb& box = collider.box;
+	const glm::vec2 extentX = box.axisX * box.halfExtents.x;
+	const glm::vec2 extentY = box.axisY * box.halfExtents.y;
+	const glm::vec2 corners[5] = {
+		box.center - extentX - extentY,
+		box.center + extentX - extentY,
+		box.center + extentX + extentY,
+		box.center - extentX + extentY,
+		box.center - extentX - extentY,
+	};
+
+	std::array<SDL_FPoint, 5> points;
+	for (size_t i = 0; i < points.size(); ++i) {
+		points[i] = { corners[i].x - cameraPos.x, corners[i].y - cameraPos.y };
+	}
+
+	SDL_RenderDrawLinesF(&renderer, points.data(), static_cast<int>(points.size()));
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Utilities/AabbBatch.h"
+#include "CollisionSystem.h"
+#include "../Renderer/RenderStats.h"
 
 struct SDL_Renderer;
 struct SDL_Rect;
@@ -12,13 +15,18 @@ class DebugRenderSystem : public System
 public:
 	DebugRenderSystem();
 
-	void Update(SDL_Renderer& renderer, const SDL_Rect& camera);
+	void Update(SDL_Renderer& renderer, const SDL_Rect& camera, const CollisionSystem& collisionSystem, RenderStats& stats);
 	void HandleInput(const SDL_Event& event);
 
 private:
-	void DrawColliders(SDL_Renderer& renderer, const SDL_Rect& camera);
+	void DrawColliders(SDL_Renderer& renderer, const SDL_Rect& camera, const CollisionSystem& collisionSystem, RenderStats& stats);
+	void DrawCollider(SDL_Renderer& renderer, const SDL_Rect& camera, const WorldCollider& collider);
 
 private:
 	bool colliderDrawingEnabled;
+
+	// Collider bounds of the frame, culled against the camera in batches.
+	AabbBatch colliderAabbs;
+	std::vector<WorldCollider> colliders;
 };
 
@@ -9,11 +9,14 @@
 #include <glm/glm.hpp>
 #include <SDL.h>
 #include <utility>
+#include <cstdio>
 
 const glm::ivec2 textOffset = { 0, 0 };
 const glm::ivec2 healthBarOffset = { 0, 10 };
 const glm::ivec2 healthBarDimensions = { 24, 4 };
 
+const std::string healthFontAssetId = "charriot-font-10";
+
 const SDL_Color fullHealthColor = { 0, 255, 0, 255 };
 const SDL_Color halfHealthColor = { 255, 195, 0, 255 };
 const SDL_Color noHealthColor = { 255, 0, 0, 255 };
@@ -28,13 +31,21 @@ SDL_Color LerpColor(const SDL_Color& start, const SDL_Color& end, const float t)
 }
 
 HealthDisplaySystem::HealthDisplaySystem()
+	: isGlyphAtlasRequested(false)
 {
 	RequireComponent<HealthComponent>();
 	RequireComponent<TransformComponent>();
 	RequireComponent<SpriteComponent>();
 }
 
-void HealthDisplaySystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera)
+void HealthDisplaySystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha)
+{
+	drawCommands.clear();
+	Record(drawCommands, camera, renderAlpha);
+	Submit(renderer, assetStore, drawCommands, stats);
+}
+
+void HealthDisplaySystem::Record(std::vector<HealthDrawCommand>& commands, const SDL_Rect& camera, const float renderAlpha)
 {
 	for (Entity entity : GetSystemEntities()) {
 		const TransformComponent& transform = entity.GetComponent<TransformComponent>();
@@ -46,38 +57,59 @@ void HealthDisplaySystem::Update(SDL_Renderer& renderer, const AssetStore& asset
 									? LerpColor(halfHealthColor, fullHealthColor, (healthRatio - 0.5f) * 2.0f)
 									: LerpColor(noHealthColor, halfHealthColor, healthRatio * 2.0f);
 
-		SDL_SetRenderDrawColor(&renderer, healthColor.r, healthColor.g, healthColor.b, healthColor.a);
+		const glm::vec2 position = glm::mix(transform.previousPosition, transform.position, renderAlpha);
+
+		const int textPosX = static_cast<int>(position.x) + textOffset.x - camera.x;
+		const int textPosY = static_cast<int>(position.y) - static_cast<int>(sprite.height * transform.scale.y / 2.0f) + textOffset.y - camera.y;
+
+		const int barPosX = static_cast<int>(position.x) + healthBarOffset.x - camera.x;
+		const int barPosY = static_cast<int>(position.y - (sprite.height * transform.scale.y / 2.0f) + healthBarOffset.y - camera.y);
+
+		commands.push_back({ glm::vec2(textPosX, textPosY), glm::vec2(barPosX, barPosY), healthColor, healthRatio, health.health });
+	}
+}
 
-		// Update health text
+void HealthDisplaySystem::Submit(SDL_Renderer& renderer, const AssetStore& assetStore, const std::vector<HealthDrawCommand>& commands, RenderStats& stats)
+{
+	if (!isGlyphAtlasRequested) {
+		// Labels only ever show a number and the unit, render those glyphs once.
+		glyphAtlas.Build(renderer, assetStore.GetFont(healthFontAssetId), "-0123456789hp");
+		isGlyphAtlasRequested = true;
+	}
 
-		const std::string healthText(std::to_string(health.health) + "hp");
-		SDL_Surface* surface = TTF_RenderText_Blended(assetStore.GetFont("charriot-font-10"), healthText.c_str(), healthColor);
-		SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
-		SDL_FreeSurface(surface);
+	spriteBatch.Begin(renderer);
 
-		const int textPosX = static_cast<int>(transform.position.x) + textOffset.x - camera.x;
-		const int textPosY = static_cast<int>(transform.position.y) - static_cast<int>(sprite.height * transform.scale.y / 2.0f) + textOffset.y - camera.y;
+	// All bars first and then all labels, so they are one draw call each.
+	for (const HealthDrawCommand& command : commands) {
+		DrawHealthBar(command.barPosition, command.healthRatio, command.color);
+	}
 
-		int labelWidth = 0, labelHeight = 0;
-		SDL_QueryTexture(texture, nullptr, nullptr, &labelWidth, &labelHeight);
-		
-		const SDL_Rect textRect = { textPosX, textPosY, labelWidth, labelHeight };
-		SDL_RenderCopy(&renderer, texture, nullptr, &textRect);
+	for (const HealthDrawCommand& command : commands) {
+		char healthText[16];
+		snprintf(healthText, sizeof(healthText), "%dhp", command.health);
+		glyphAtlas.DrawText(spriteBatch, healthText, command.labelPosition, command.color);
+	}
 
-		// Draw health bar frame
+	spriteBatch.End();
 
-		const int barPosX = static_cast<int>(transform.position.x) + healthBarOffset.x - camera.x;
-		const int barPosY = static_cast<int>(transform.position.y - (sprite.height * transform.scale.y / 2.0f) + healthBarOffset.y - camera.y);
-		const SDL_Rect healthBarFrameRect = { barPosX, barPosY, healthBarDimensions.x, healthBarDimensions.y };
-		SDL_RenderDrawRect(&renderer, &healthBarFrameRect);
+	stats.drawCalls += spriteBatch.GetNumDrawCalls();
+	stats.textureSwitches += spriteBatch.GetNumTextureSwitches();
+}
 
-		// Draw filled part of the health bar
+/**
+ * @brief Batches the one pixel frame of the bar and its filled part.
+ */
+void HealthDisplaySystem::DrawHealthBar(const glm::vec2& position, const float healthRatio, const SDL_Color& color)
+{
+	const glm::vec2 size(healthBarDimensions);
 
-		SDL_Rect healthBarRect = healthBarFrameRect;
-		healthBarRect.w = static_cast<int>(healthBarRect.w * healthRatio);
-		SDL_RenderFillRect(&renderer, &healthBarRect);
+	spriteBatch.DrawRect({ position.x, position.y, size.x, 1.0f }, color);
+	spriteBatch.DrawRect({ position.x, position.y + size.y - 1.0f, size.x, 1.0f }, color);
+	spriteBatch.DrawRect({ position.x, position.y + 1.0f, 1.0f, size.y - 2.0f }, color);
+	spriteBatch.DrawRect({ position.x + size.x - 1.0f, position.y + 1.0f, 1.0f, size.y - 2.0f }, color);
 
-		// Cleanup texture
-		SDL_DestroyTexture(texture);
+	const float fillWidth = static_cast<float>(static_cast<int>(size.x * healthRatio));
+	if (fillWidth > 0.0f) {
+		spriteBatch.DrawRect({ position.x, position.y, fillWidth, size.y }, color);
 	}
-}
\ No newline at end of file
+}
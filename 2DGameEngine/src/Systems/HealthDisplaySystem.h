@@ -1,19 +1,57 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/SpriteBatch.h"
+#include "../Renderer/GlyphAtlas.h"
+#include "../Renderer/RenderStats.h"
+
+#include <SDL.h>
+#include <glm/glm.hpp>
+#include <vector>
 
 struct SDL_Renderer;
 struct SDL_Rect;
 class AssetStore;
 
+/**
+ * @brief Health label and bar of an entity, in screen space.
+ */
+struct HealthDrawCommand
+{
+	glm::vec2 labelPosition;
+	glm::vec2 barPosition;
+	SDL_Color color;
+	float healthRatio;
+	int health;
+};
+
+/**
+ * @brief Draws the health label and bar above every entity with health.
+ *
+ * Labels are drawn from a glyph atlas of the health font built on the first update,
+ * bars as untextured quads. Both go through one sprite batch, two draw calls in total.
+ *
+ * Like the RenderSystem, drawing can be split into Record and Submit, and positions
+ * are interpolated by the render alpha.
+ */
 class HealthDisplaySystem : public System
 {
 public:
 	HealthDisplaySystem();
 
-	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera);
+	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha = 1.0f);
+
+	void Record(std::vector<HealthDrawCommand>& commands, const SDL_Rect& camera, const float renderAlpha = 1.0f);
+	void Submit(SDL_Renderer& renderer, const AssetStore& assetStore, const std::vector<HealthDrawCommand>& commands, RenderStats& stats);
+
+private:
+	void DrawHealthBar(const glm::vec2& position, const float healthRatio, const SDL_Color& color);
 
 private:
-	void DrawHealthBar();
+	GlyphAtlas glyphAtlas;
+	bool isGlyphAtlasRequested;
+
+	SpriteBatch spriteBatch;
+	std::vector<HealthDrawCommand> drawCommands;
 };
 
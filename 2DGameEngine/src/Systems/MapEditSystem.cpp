@@ -1,7 +1,6 @@
 #include "MapEditSystem.h"
 
 #include "../Components/SpriteComponent.h"
-#include "../Components/TransformComponent.h"
 #include "../Events/MouseEvents.h"
 #include "../EventBus/EventBus.h"
 
@@ -9,8 +8,6 @@
 
 #include "../Logger/Logger.h"
 
-#include "../Utilities/Geometry.h"
-
 MapEditSystem::MapEditSystem(SceneManager& sceneManager)
 	: sceneManager(sceneManager)
 {
@@ -69,24 +66,6 @@ void MapEditSystem::OnMouseButtonClicked(MouseButtonEvent& event)
 		return;
 	}
 
-	const TileProperties& activeTile = sceneManager.GetActiveTile();
-	const glm::ivec2 tileCenterPos = activeTile.posWorld + glm::ivec2(activeTile.width / 2, activeTile.height / 2);
-
-	// Check if there's a tile on that position
-	for (Entity entity : GetSystemEntities()) {
-		if (!entity.HasTag("tile")) {
-			continue;
-		}
-
-		const TransformComponent& transform = entity.GetComponent<TransformComponent>();
-		const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
-		const glm::vec2 maxPos(transform.position + glm::vec2(sprite.width, sprite.height));
-		const Aabb entitySpriteAabb(transform.position, maxPos);
-
-		if (entitySpriteAabb.Contains(tileCenterPos)) {
-			entity.Kill();
-		}
-	}
-
+	// Replaces the tile already on that position.
 	sceneManager.AddActiveTile();
 }
@@ -6,6 +6,7 @@
 
 #include "../EventBus/EventBus.h"
 #include "../Events/CollisionEvent.h"
+#include "../Events/TileCollisionEvent.h"
 
 #include "../Game/Game.h"
 
@@ -50,17 +51,19 @@ void MovementSystem::Update(const float deltaTime)
 
 	for (Entity entity: GetSystemEntities()) {
 		TransformComponent& transform = entity.GetComponent<TransformComponent>();
-		const RigidBodyComponent& rigidbody = entity.GetComponent<RigidBodyComponent>();
+		RigidBodyComponent& rigidbody = entity.GetComponent<RigidBodyComponent>();
 		const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
 		const glm::vec2 entitySize((sprite.width * transform.scale.x), (sprite.height * transform.scale.y));
 
 		const glm::vec2 deltaPosition = rigidbody.velocity * deltaTime;
 		transform.position += deltaPosition;
+		rigidbody.lastDisplacement = deltaPosition;
 
 		if (entity.HasTag("player")) {
 			if (!isFullyInsideMap(transform.position, entitySize)) {
 				// Prevent player to pass map borders
 				transform.position -= deltaPosition;
+				rigidbody.lastDisplacement = glm::vec2(0.0f);
 			}
 		}
 		else if (entity.BelongsToGroup("projectiles")) {
@@ -78,20 +81,60 @@ void MovementSystem::Update(const float deltaTime)
 
 void MovementSystem::SubscribeToEvents(EventBus& eventBus)
 {
-	eventBus.SubscribeToEvents(this, &MovementSystem::OnCollisionHappened);
+	eventBus.SubscribeToEvents(this, &MovementSystem::OnCollisionBatch);
+	eventBus.SubscribeToEvents(this, &MovementSystem::OnTileCollision);
 }
 
-void MovementSystem::OnCollisionHappened(CollisionEvent& event)
+void MovementSystem::OnCollisionBatch(CollisionBatchEvent& event)
 {
-	Entity a = event.a;
-	Entity b = event.b;
+	for (const CollisionPair& pair : event.entered) {
+		Entity a = pair.a;
+		Entity b = pair.b;
 
-	if (a.BelongsToGroup("enemies") && b.BelongsToGroup("obstacles")) {
-		OnEnemyHitsObstacle(a, b);
+		if (a.BelongsToGroup("enemies") && b.BelongsToGroup("obstacles")) {
+			OnEnemyHitsObstacle(a, b);
+		}
+
+		if (a.BelongsToGroup("obstacles") && b.BelongsToGroup("enemies")) {
+			OnEnemyHitsObstacle(b, a);
+		}
+	}
+}
+
+/**
+ * @brief Solid tiles block the player, bounce enemies and stop projectiles.
+ *
+ * Entities are pushed out every update they overlap the tiles, so pushing into a wall
+ * or spawning inside of it does not let them through.
+ */
+void MovementSystem::OnTileCollision(TileCollisionEvent& event)
+{
+	if (!event.isTouching) {
+		return;
+	}
+
+	Entity entity = event.entity;
+	if (entity.BelongsToGroup("projectiles")) {
+		entity.Kill();
+		return;
+	}
+
+	if (!entity.HasComponent<RigidBodyComponent>()) {
+		return;
 	}
 
-	if (a.BelongsToGroup("obstacles") && b.BelongsToGroup("enemies")) {
-		OnEnemyHitsObstacle(b, a);
+	TransformComponent& transform = entity.GetComponent<TransformComponent>();
+	transform.position += event.penetration;
+
+	// Enemies turn around once per contact.
+	if (!event.wasTouching && entity.BelongsToGroup("enemies")) {
+		RigidBodyComponent& rigidbody = entity.GetComponent<RigidBodyComponent>();
+		rigidbody.velocity *= -1.0f;
+
+		if (entity.HasComponent<SpriteComponent>()) {
+			SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
+			sprite.flip = (sprite.flip == SDL_FLIP_NONE) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+		}
 	}
 }
 
@@ -105,11 +148,6 @@ void MovementSystem::OnEnemyHitsObstacle(Entity enemy, Entity obstacle)
 
 		SpriteComponent& sprite = enemy.GetComponent<SpriteComponent>();
 		sprite.flip = (sprite.flip == SDL_FLIP_NONE) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-
-		// A little push to prevent enemy from being stuck in an endless collision loop.
-		// To have more robust solution, we can move the enemy out of the box collider area of obstacle.
-		TransformComponent& transform = enemy.GetComponent<TransformComponent>();
-		transform.position += rigidbody.velocity * (1.0f / 120.0f);
 	}
 
 }
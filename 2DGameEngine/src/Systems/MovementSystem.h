@@ -3,7 +3,8 @@
 #include "../ECS/ECS.h"
 
 class EventBus;
-class CollisionEvent;
+class CollisionBatchEvent;
+class TileCollisionEvent;
 
 class MovementSystem : public System
 {
@@ -14,7 +15,8 @@ public:
 	void SubscribeToEvents(EventBus& eventBus);
 
 private:
-	void OnCollisionHappened(CollisionEvent& event);
+	void OnCollisionBatch(CollisionBatchEvent& event);
+	void OnTileCollision(TileCollisionEvent& event);
 	void OnEnemyHitsObstacle(Entity enemy, Entity obstacle);
 };
 
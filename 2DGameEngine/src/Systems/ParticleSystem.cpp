@@ -0,0 +1,188 @@
+#include "ParticleSystem.h"
+
+#include "../Components/TransformComponent.h"
+#include "../Components/SpriteComponent.h"
+#include "../Components/ParticleEmitterComponent.h"
+#include "../AssetStore/AssetStore.h"
+
+#include <cmath>
+
+void ParticleDrawList::Clear()
+{
+	vertices.clear();
+	batches.clear();
+}
+
+ParticleSystem::ParticleSystem()
+{
+	RequireComponent<TransformComponent>();
+	RequireComponent<ParticleEmitterComponent>();
+}
+
+void ParticleSystem::Update(const float deltaTimeSec)
+{
+	for (Entity& entity : GetSystemEntities()) {
+		const TransformComponent& transform = entity.GetComponent<TransformComponent>();
+		ParticleEmitterComponent& emitter = entity.GetComponent<ParticleEmitterComponent>();
+
+		unsigned numParticles = emitter.burstCount;
+		emitter.burstCount = 0;
+
+		if (emitter.isEmitting && emitter.emitRate > 0.0f) {
+			emitter.emitAccumulator += emitter.emitRate * deltaTimeSec;
+			const float wholeParticles = std::floor(emitter.emitAccumulator);
+			emitter.emitAccumulator -= wholeParticles;
+			numParticles += static_cast<unsigned>(wholeParticles);
+		}
+
+		if (numParticles == 0) {
+			continue;
+		}
+
+		// Emit from the center of the sprite, like the projectiles.
+		glm::vec2 emitPosition = transform.position;
+		if (entity.HasComponent<SpriteComponent>()) {
+			const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
+			emitPosition.x += transform.scale.x * (sprite.width / 2.0f);
+			emitPosition.y += transform.scale.y * (sprite.height / 2.0f);
+		}
+
+		Emit(emitter, emitPosition, numParticles);
+	}
+
+	for (ParticleLayer& layer : layers) {
+		layer.pool.Update(deltaTimeSec);
+	}
+}
+
+void ParticleSystem::Emit(const ParticleEmitterComponent& emitter, const glm::vec2& position, const unsigned count)
+{
+	ParticlePool& pool = GetPool(emitter.assetId);
+
+	ParticleSpawn spawn;
+	spawn.position = position;
+	spawn.acceleration = emitter.acceleration;
+	spawn.startSize = emitter.startSize;
+	spawn.endSize = emitter.endSize;
+	spawn.startColor = emitter.startColor;
+	spawn.endColor = emitter.endColor;
+
+	const float halfSpreadDeg = emitter.spreadDeg / 2.0f;
+	for (unsigned i = 0; i < count; ++i) {
+		const float angle = glm::radians(emitter.directionDeg + RandomRange(-halfSpreadDeg, halfSpreadDeg));
+		const float speed = RandomRange(emitter.minSpeed, emitter.maxSpeed);
+		spawn.velocity = glm::vec2(std::cos(angle), std::sin(angle)) * speed;
+		spawn.lifetimeS = RandomRange(emitter.minLifetimeS, emitter.maxLifetimeS);
+
+		if (!pool.Spawn(spawn)) {
+			break;
+		}
+	}
+}
+
+void ParticleSystem::Render(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats)
+{
+	frameDrawList.Clear();
+	Record(frameDrawList, assetStore, camera);
+	Submit(renderer, frameDrawList, stats);
+}
+
+void ParticleSystem::Record(ParticleDrawList& drawList, const AssetStore& assetStore, const SDL_Rect& camera) const
+{
+	for (const ParticleLayer& layer : layers) {
+		if (layer.pool.GetSize() == 0) {
+			continue;
+		}
+
+		// Pixel coordinates only, the texture size is queried in Submit, Record must not call SDL.
+		SDL_Texture* texture = nullptr;
+		SDL_FRect uvRect = { 0.0f, 0.0f, 0.0f, 0.0f };
+		if (!layer.assetId.empty()) {
+			const TextureRegion& textureRegion = assetStore.GetTextureRegion(layer.assetId);
+			texture = textureRegion.texture;
+			uvRect = {
+				static_cast<float>(textureRegion.rect.x),
+				static_cast<float>(textureRegion.rect.y),
+				static_cast<float>(textureRegion.rect.w),
+				static_cast<float>(textureRegion.rect.h)
+			};
+		}
+
+		const size_t firstVertex = drawList.vertices.size();
+		const size_t numQuads = layer.pool.AppendQuads(drawList.vertices, camera, uvRect);
+		if (numQuads == 0) {
+			continue;
+		}
+
+		// The quads of a layer on the same atlas page as the previous one continue its batch.
+		if (!drawList.batches.empty() && drawList.batches.back().texture == texture) {
+			drawList.batches.back().numQuads += numQuads;
+		}
+		else {
+			drawList.batches.push_back({ texture, firstVertex, numQuads });
+		}
+	}
+}
+
+void ParticleSystem::Submit(SDL_Renderer& renderer, ParticleDrawList& drawList, RenderStats& stats)
+{
+	for (const ParticleDrawList::Batch& batch : drawList.batches) {
+		SDL_Vertex* vertices = &drawList.vertices[batch.firstVertex];
+		const size_t numVertices = batch.numQuads * 4;
+
+		if (batch.texture) {
+			int textureWidth = 1;
+			int textureHeight = 1;
+			SDL_QueryTexture(batch.texture, nullptr, nullptr, &textureWidth, &textureHeight);
+
+			const float inverseTextureWidth = 1.0f / textureWidth;
+			const float inverseTextureHeight = 1.0f / textureHeight;
+			for (size_t i = 0; i < numVertices; ++i) {
+				vertices[i].tex_coord.x *= inverseTextureWidth;
+				vertices[i].tex_coord.y *= inverseTextureHeight;
+			}
+		}
+
+		const size_t numIndices = batch.numQuads * 6;
+		for (size_t quad = quadIndices.size() / 6; quad < batch.numQuads; ++quad) {
+			const int firstVertex = static_cast<int>(quad * 4);
+			quadIndices.insert(quadIndices.end(), { firstVertex, firstVertex + 1, firstVertex + 2, firstVertex + 2, firstVertex + 3, firstVertex });
+		}
+
+		SDL_RenderGeometry(&renderer, batch.texture, vertices, static_cast<int>(numVertices), quadIndices.data(), static_cast<int>(numIndices));
+
+		++stats.drawCalls;
+		++stats.textureSwitches;
+	}
+}
+
+size_t ParticleSystem::GetNumParticles() const
+{
+	size_t numParticles = 0;
+	for (const ParticleLayer& layer : layers) {
+		numParticles += layer.pool.GetSize();
+	}
+
+	return numParticles;
+}
+
+ParticlePool& ParticleSystem::GetPool(const std::string& assetId)
+{
+	for (ParticleLayer& layer : layers) {
+		if (layer.assetId == assetId) {
+			return layer.pool;
+		}
+	}
+
+	layers.push_back({ assetId, ParticlePool(MAX_PARTICLES_PER_LAYER) });
+	return layers.back().pool;
+}
+
+float ParticleSystem::RandomRange(const float min, const float max)
+{
+	if (max <= min) {
+		return min;
+	}
+
+	return std::uniform_real_distribution<float>(min, max)(randomEngine);
+}
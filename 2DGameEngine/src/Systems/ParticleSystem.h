@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../ECS/ECS.h"
+#include "../Utilities/ParticlePool.h"
+#include "../Renderer/RenderStats.h"
+
+#include <SDL.h>
+#include <glm/glm.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+class AssetStore;
+struct ParticleEmitterComponent;
+
+// Live particles per image, more are dropped.
+const size_t MAX_PARTICLES_PER_LAYER = 128 * 1024;
+
+/**
+ * @brief Particle vertices of one frame, one batch per texture.
+ *
+ * Texture coordinates are recorded in pixels, Submit normalizes them by the texture size.
+ */
+struct ParticleDrawList
+{
+	struct Batch
+	{
+		SDL_Texture* texture;
+		size_t firstVertex;
+		size_t numQuads;
+	};
+
+	void Clear();
+
+	std::vector<SDL_Vertex> vertices;
+	std::vector<Batch> batches;
+};
+
+/**
+ * @brief Spawns particles from the emitter components and simulates them outside the ECS.
+ *
+ * Particles are not entities. They live in one ParticlePool per image and are drawn
+ * as quads with one SDL_RenderGeometry call per texture, so images packed into the
+ * same atlas page share a call. Like the RenderSystem, drawing can be split into
+ * Record and Submit. Particles are not interpolated between ticks.
+ */
+class ParticleSystem : public System
+{
+public:
+	ParticleSystem();
+
+	void Update(const float deltaTimeSec);
+
+	/**
+	 * @brief Spawns count particles with the emitter's settings at the position, e.g. for an explosion.
+	 */
+	void Emit(const ParticleEmitterComponent& emitter, const glm::vec2& position, const unsigned count);
+
+	void Render(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats);
+
+	void Record(ParticleDrawList& drawList, const AssetStore& assetStore, const SDL_Rect& camera) const;
+	void Submit(SDL_Renderer& renderer, ParticleDrawList& drawList, RenderStats& stats);
+
+	size_t GetNumParticles() const;
+
+private:
+	struct ParticleLayer
+	{
+		std::string assetId;
+		ParticlePool pool;
+	};
+
+	ParticlePool& GetPool(const std::string& assetId);
+	float RandomRange(const float min, const float max);
+
+private:
+	std::vector<ParticleLayer> layers;
+	std::mt19937 randomEngine;
+
+	ParticleDrawList frameDrawList;
+
+	// 0, 1, 2, 2, 3, 0 for every quad, shared by all batches.
+	std::vector<int> quadIndices;
+};
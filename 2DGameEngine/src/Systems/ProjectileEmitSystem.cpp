@@ -112,10 +112,10 @@ void ProjectileEmitSystem::CreateProjectile(const ProjectileInfo& info, Registry
 	Entity projectile = registry.CreateEntity();
 	projectile.Group("projectiles");
 	projectile.AddComponent<TransformComponent>(info.position, info.scale);
-	projectile.AddComponent<RigidBodyComponent>(info.velocity);
+	projectile.AddComponent<RigidBodyComponent>(info.velocity, true /* continuousCollision */);
 	projectile.AddComponent<ProjectileComponent>(info.hitDamage, info.durationS, info.isFriendly);
 	projectile.AddComponent<SpriteComponent>("bullet-texture", 4, 4, 4 /* zIndex */);
-	projectile.AddComponent<BoxColliderComponent>(4, 4);
+	projectile.AddComponent<BoxColliderComponent>(4, 4, glm::vec2(0), CollisionLayer::LAYER_projectile);
 }
 
 
@@ -13,7 +13,7 @@
 
 #include "../Utilities/FileDialog.h"
 
-void RenderEditorGUISystem::Update(Registry& registry, SceneManager& sceneManager, SDL_Renderer& renderer, AssetStore& assetStore)
+void RenderEditorGUISystem::Update(Registry& registry, SceneManager& sceneManager, SDL_Renderer& renderer, AssetStore& assetStore, const RenderStats& renderStats)
 {
     // Draw ImGui objects
     ImGui_ImplSDLRenderer_NewFrame();
@@ -53,6 +53,11 @@ void RenderEditorGUISystem::Update(Registry& registry, SceneManager& sceneManage
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("View")) {
+            ImGui::MenuItem("Render stats", nullptr, &isRenderStatsShown);
+            ImGui::EndMenu();
+        }
+
         ImGui::EndMainMenuBar();
 	}
     
@@ -63,6 +68,10 @@ void RenderEditorGUISystem::Update(Registry& registry, SceneManager& sceneManage
         DisplayLoadedTileset(sceneManager, assetStore);
     }
 
+    if (isRenderStatsShown) {
+        ShowRenderStatsWindow(renderStats);
+    }
+
 
     ImGui::Render();
     ImGui_ImplSDLRenderer_RenderDrawData(ImGui::GetDrawData());
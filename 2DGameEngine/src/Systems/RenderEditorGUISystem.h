@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/RenderStats.h"
 
 #include <glm/glm.hpp>
 #include <string>
@@ -16,7 +17,7 @@ class RenderEditorGUISystem : public System
 public:
 	RenderEditorGUISystem() = default;
 
-	void Update(Registry& registry, SceneManager& sceneManager, SDL_Renderer& renderer, AssetStore& assetStore);
+	void Update(Registry& registry, SceneManager& sceneManager, SDL_Renderer& renderer, AssetStore& assetStore, const RenderStats& renderStats);
 
 private:
 	void DisplayLoadedTileset(SceneManager& sceneManager, AssetStore& assetStore);
@@ -26,6 +27,8 @@ private:
 	std::string activeTilesetId;
 	glm::ivec2 activeTilesetDimensions;
 
+	bool isRenderStatsShown = false;
+
 };
 
 
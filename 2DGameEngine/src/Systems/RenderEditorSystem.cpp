@@ -20,9 +20,20 @@ RenderEditorSystem::RenderEditorSystem()
 	RequireComponent<SpriteComponent>();
 }
 
-void RenderEditorSystem::Update(SceneManager& sceneManager, SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera)
+void RenderEditorSystem::Update(SceneManager& sceneManager, SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats)
 {
-	DrawGrid(sceneManager, renderer, camera);
+	DrawGrid(sceneManager, renderer, camera, stats);
+
+	SDL_Texture* lastTexture = nullptr;
+	sceneManager.GetTileMap().ForEachVisibleChunk(renderer, assetStore, camera, [&](SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect) {
+		SDL_RenderCopyF(&renderer, texture, &srcRect, &destRect);
+
+		++stats.drawCalls;
+		if (texture != lastTexture) {
+			++stats.textureSwitches;
+			lastTexture = texture;
+		}
+	});
 
 	// Sort the entities according to zIndex
 	std::vector<Entity> entitiesSorted(GetSystemEntities());
@@ -42,9 +53,11 @@ void RenderEditorSystem::Update(SceneManager& sceneManager, SDL_Renderer& render
 		const bool isEntityOutOfCameraView = ((entityPosX + entityWidth) < 0) || (entityPosX > camera.w) || 
 											 ((entityPosY + entityHeight) < 0) || (entityPosY > camera.h);
 
+		++stats.spritesVisited;
 		if (isEntityOutOfCameraView) {
 			// Cull the sprites that are out of camera view.
 			assert(!sprite.isFixed);
+			++stats.spritesCulled;
 			continue;
 		}
 
@@ -55,19 +68,35 @@ void RenderEditorSystem::Update(SceneManager& sceneManager, SDL_Renderer& render
 			entityHeight
 		};
 
+		const TextureRegion& textureRegion = assetStore.GetTextureRegion(sprite.assetId);
+		const SDL_Rect srcRect = {
+			textureRegion.rect.x + sprite.srcRect.x,
+			textureRegion.rect.y + sprite.srcRect.y,
+			sprite.srcRect.w,
+			sprite.srcRect.h
+		};
+
 		SDL_RenderCopyEx(
 			&renderer,
-			assetStore.GetTexture(sprite.assetId),
-			&sprite.srcRect,
+			textureRegion.texture,
+			&srcRect,
 			&destRect,
 			transform.rotation,
 			nullptr,
 			sprite.flip
 		);
+
+		++stats.drawCalls;
+		if (textureRegion.texture != lastTexture) {
+			++stats.textureSwitches;
+			lastTexture = textureRegion.texture;
+		}
 	}
 
 	if (sceneManager.HasActiveTile()) {
 		DrawSelectedTile(sceneManager, renderer, assetStore, camera);
+		++stats.drawCalls;
+		++stats.textureSwitches;
 	}
 }
 
@@ -106,23 +135,52 @@ void RenderEditorSystem::DrawSelectedTile(SceneManager& sceneManager, SDL_Render
 
 }
 
-void RenderEditorSystem::DrawGrid(const SceneManager& sceneManager, SDL_Renderer& renderer, const SDL_Rect& camera)
+/**
+ * @brief Draws the cells in camera view only, grouped by color, so the grid costs four draw calls at any size.
+ */
+void RenderEditorSystem::DrawGrid(const SceneManager& sceneManager, SDL_Renderer& renderer, const SDL_Rect& camera, RenderStats& stats)
 {
 	const GridProperties& gridProperties = sceneManager.GetGridProperties();
+	const int cellSize = static_cast<int>(gridProperties.cellSize);
+	if (cellSize <= 0 || gridProperties.cellCountX == 0 || gridProperties.cellCountY == 0) {
+		return;
+	}
 
-	for (size_t i = 0; i < gridProperties.cellCountY; ++i) {
-		for (size_t j = 0; j < gridProperties.cellCountX; ++j) {
+	// Cell range under the camera, rounded outwards.
+	const auto floorDiv = [](const int value, const int divisor) {
+		return (value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor);
+	};
+
+	const int firstColumn = std::max(floorDiv(camera.x - gridProperties.startPos.x, cellSize), 0);
+	const int firstRow = std::max(floorDiv(camera.y - gridProperties.startPos.y, cellSize), 0);
+	const int lastColumn = std::min(floorDiv(camera.x + camera.w - 1 - gridProperties.startPos.x, cellSize), static_cast<int>(gridProperties.cellCountX) - 1);
+	const int lastRow = std::min(floorDiv(camera.y + camera.h - 1 - gridProperties.startPos.y, cellSize), static_cast<int>(gridProperties.cellCountY) - 1);
+
+	for (std::vector<SDL_Rect>& cellRects : gridCellRects) {
+		cellRects.clear();
+	}
+
+	for (int i = firstRow; i <= lastRow; ++i) {
+		for (int j = firstColumn; j <= lastColumn; ++j) {
 
-			const int xPosWorld = gridProperties.startPos.x + (j * gridProperties.cellSize);
-			const int yPosWorld = gridProperties.startPos.y + (i * gridProperties.cellSize);
+			const int xPosWorld = gridProperties.startPos.x + (j * cellSize);
+			const int yPosWorld = gridProperties.startPos.y + (i * cellSize);
 			const glm::ivec2 posScreen = sceneManager.WorldToScreen({ xPosWorld, yPosWorld });
-			const SDL_Rect cell = { posScreen.x, posScreen.y, gridProperties.cellSize, gridProperties.cellSize};
 
-			const SDL_Color& currentCellColor = ((i + j) % 2) ? gridProperties.cellColor1 : gridProperties.cellColor2;
-			SetRenderDrawColor(renderer, currentCellColor);
-			SDL_RenderDrawRect(&renderer, &cell);
-			SDL_RenderFillRect(&renderer, &cell);
+			gridCellRects[(i + j) % 2].push_back({ posScreen.x, posScreen.y, cellSize, cellSize });
 		}
 	}
 
+	const std::array<SDL_Color, 2> cellColors = { gridProperties.cellColor2, gridProperties.cellColor1 };
+	for (size_t colorIndex = 0; colorIndex < gridCellRects.size(); ++colorIndex) {
+		const std::vector<SDL_Rect>& cellRects = gridCellRects[colorIndex];
+		if (cellRects.empty()) {
+			continue;
+		}
+
+		SetRenderDrawColor(renderer, cellColors[colorIndex]);
+		SDL_RenderDrawRects(&renderer, cellRects.data(), static_cast<int>(cellRects.size()));
+		SDL_RenderFillRects(&renderer, cellRects.data(), static_cast<int>(cellRects.size()));
+		stats.drawCalls += 2;
+	}
 }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/RenderStats.h"
 
+#include <SDL_rect.h>
+#include <array>
+#include <vector>
 
 struct SDL_Renderer;
-struct SDL_Rect;
 class AssetStore;
 class SceneManager;
 
@@ -13,8 +16,12 @@ class RenderEditorSystem : public System
 public:
 	RenderEditorSystem();
 
-	void Update(SceneManager& sceneManager, SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera);
+	void Update(SceneManager& sceneManager, SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats);
 
 	void DrawSelectedTile(SceneManager& sceneManager, SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera);
-	void DrawGrid(const SceneManager& sceneManager, SDL_Renderer& renderer, const SDL_Rect& camera);
+	void DrawGrid(const SceneManager& sceneManager, SDL_Renderer& renderer, const SDL_Rect& camera, RenderStats& stats);
+
+private:
+	// Visible grid cells of each of the two cell colors, refilled every frame.
+	std::array<std::vector<SDL_Rect>, 2> gridCellRects;
 };
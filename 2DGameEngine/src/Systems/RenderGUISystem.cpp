@@ -11,7 +11,7 @@
 #include <imgui/imgui_impl_sdl2.h>
 #include <imgui/imgui_impl_sdlrenderer.h>
 
-void RenderGUISystem::Update(Registry& registry, const SDL_Rect& camera)
+void RenderGUISystem::Update(Registry& registry, const SDL_Rect& camera, const RenderStats& renderStats)
 {
 	// Draw ImGui objects
 	ImGui_ImplSDLRenderer_NewFrame();
@@ -110,6 +110,9 @@ void RenderGUISystem::Update(Registry& registry, const SDL_Rect& camera)
 	}
 	ImGui::End();
 
+	// Counts what was drawn so far this frame, i.e. everything but the GUI.
+	ShowRenderStatsWindow(renderStats);
+
 	ImGui::Render();
 	ImGui_ImplSDLRenderer_RenderDrawData(ImGui::GetDrawData());
 
@@ -128,7 +131,7 @@ void RenderGUISystem::CreateEnemy(Registry& registry, const EnemyProperties& pro
 	enemy.AddComponent<TransformComponent>(properties.position, properties.scale, properties.rotation);
 	enemy.AddComponent<RigidBodyComponent>(properties.velocity);
 	enemy.AddComponent<SpriteComponent>(properties.assetId, spriteWidth, spriteHeight, enemyZIndex);
-	enemy.AddComponent<BoxColliderComponent>(colliderWidth, colliderHeight);
+	enemy.AddComponent<BoxColliderComponent>(colliderWidth, colliderHeight, glm::vec2(0), CollisionLayer::LAYER_enemy);
 	enemy.AddComponent<ProjectileEmitterComponent>(properties.projectileVelocity, properties.repeatFrequencyS, 
 												   properties.projectileDurationS, properties.hitDamage, properties.isFriendly);
 	enemy.AddComponent<HealthComponent>(properties.health);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/RenderStats.h"
 
 #include <glm/glm.hpp>
 
@@ -12,7 +13,7 @@ class RenderGUISystem : public System
 public:
 	RenderGUISystem() = default;
 
-	void Update(Registry& registry, const SDL_Rect& camera);
+	void Update(Registry& registry, const SDL_Rect& camera, const RenderStats& renderStats);
 	
 private:
 	struct EnemyProperties;
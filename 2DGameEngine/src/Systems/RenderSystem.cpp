@@ -2,58 +2,165 @@
 
 #include "../Components/TransformComponent.h"
 #include "../Components/SpriteComponent.h"
+#include "../Components/RigidBodyComponent.h"
+#include "../Components/ScriptComponent.h"
 #include "../AssetStore/AssetStore.h"
 
 #include <SDL.h>
 #include <algorithm>
 #include <assert.h>
 
+const int TileMapZIndex = 0;
+
 RenderSystem::RenderSystem()
 {
 	RequireComponent<TransformComponent>();
 	RequireComponent<SpriteComponent>();
 }
 
-void RenderSystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera)
+/**
+ * @brief Screen independent bounds of the sprite, as used by the camera culling.
+ */
+static Aabb GetSpriteBounds(const Entity entity)
+{
+	const TransformComponent& transform = entity.GetComponent<TransformComponent>();
+	const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
+
+	const glm::vec2 minPos(static_cast<int>(transform.position.x), static_cast<int>(transform.position.y));
+	const glm::vec2 size(sprite.width * static_cast<int>(transform.scale.x), sprite.height * static_cast<int>(transform.scale.y));
+	return Aabb(minPos, minPos + glm::max(size, glm::vec2(0.0f)));
+}
+
+void RenderSystem::AddEntityToSystem(const Entity entity)
+{
+	System::AddEntityToSystem(entity);
+
+	if (IsStaticSprite(entity)) {
+		staticSpriteCellPerEntity[entity.GetId()] = staticSpriteGrid.Insert(entity, GetSpriteBounds(entity));
+	}
+	else {
+		movingSprites.push_back(entity);
+	}
+}
+
+void RenderSystem::RemoveEntityFromSystem(const Entity entity)
+{
+	System::RemoveEntityFromSystem(entity);
+
+	auto cellIt = staticSpriteCellPerEntity.find(entity.GetId());
+	if (cellIt != staticSpriteCellPerEntity.end()) {
+		staticSpriteGrid.Remove(entity, cellIt->second);
+		staticSpriteCellPerEntity.erase(cellIt);
+	}
+	else {
+		movingSprites.erase(std::remove(movingSprites.begin(), movingSprites.end(), entity), movingSprites.end());
+	}
+}
+
+bool RenderSystem::IsStaticSprite(const Entity entity)
+{
+	return !entity.GetComponent<SpriteComponent>().isFixed
+		&& !entity.HasComponent<RigidBodyComponent>()
+		&& !entity.HasComponent<ScriptComponent>();
+}
+
+void RenderSystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha)
+{
+	// Record the visible sprites, then draw them sorted by zIndex and texture.
+	renderQueue.Clear();
+	Record(renderQueue, assetStore, camera, stats, renderAlpha);
+	Submit(renderer, assetStore, renderQueue, camera, stats);
+}
+
+/**
+ * @brief Pushes the visible sprites to the queue. Only reads the entities, it does not call SDL.
+ */
+void RenderSystem::Record(RenderQueue& queue, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha) const
+{
+	const glm::vec2 cameraMin(camera.x, camera.y);
+	const Aabb cameraArea(cameraMin, cameraMin + glm::vec2(camera.w, camera.h));
+	staticSpriteGrid.Query(cameraArea, [&](const Entity entity) {
+		PushSprite(queue, entity, assetStore, camera, 1.0f, stats);
+	});
+
+	for (const Entity entity : movingSprites) {
+		PushSprite(queue, entity, assetStore, camera, renderAlpha, stats);
+	}
+}
+
+/**
+ * @brief Call before every simulation tick. Static sprites are skipped, they never move.
+ */
+void RenderSystem::StorePreviousPositions()
+{
+	for (const Entity entity : movingSprites) {
+		TransformComponent& transform = entity.GetComponent<TransformComponent>();
+		transform.previousPosition = transform.position;
+	}
+}
+
+/**
+ * @brief Adds the tilemap chunks to the recorded sprites and draws them all. Does not read the entities.
+ */
+void RenderSystem::Submit(SDL_Renderer& renderer, const AssetStore& assetStore, RenderQueue& queue, const SDL_Rect& camera, RenderStats& stats)
 {
-	// Sort the entities according to zIndex
-	std::vector<Entity> entitiesSorted(GetSystemEntities());
-	std::sort(entitiesSorted.begin(), entitiesSorted.end(), [](Entity a, Entity b) {
-		return a.GetComponent<SpriteComponent>().zIndex < b.GetComponent<SpriteComponent>().zIndex;
+	tileMap.ForEachVisibleChunk(renderer, assetStore, camera, [&](SDL_Texture* texture, const SDL_Rect& srcRect, const SDL_FRect& destRect) {
+		queue.Push(0 /* layer */, TileMapZIndex, texture, srcRect, destRect);
 	});
 
-	for (Entity entity : entitiesSorted) {
-		const TransformComponent& transform = entity.GetComponent<TransformComponent>();
-		const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
-
-		const int entityPosX = static_cast<int>(transform.position.x) - (sprite.isFixed ? 0 : camera.x);
-		const int entityPosY = static_cast<int>(transform.position.y) - (sprite.isFixed ? 0 : camera.y);
-		const int entityWidth = sprite.width * static_cast<int>(transform.scale.x);
-		const int entityHeight = sprite.height * static_cast<int>(transform.scale.y);
-
-		const bool isEntityOutOfCameraView = ((entityPosX + entityWidth) < 0) || (entityPosX > camera.w) || 
-											 ((entityPosY + entityHeight) < 0) || (entityPosY > camera.h);
-
-		if (isEntityOutOfCameraView) {
-			// Cull the sprites that are out of camera view.
-			assert(!sprite.isFixed);
-			continue;
-		}
-
-		const SDL_Rect destRect = {
-			entityPosX,
-			entityPosY,
-			entityWidth,
-			entityHeight
-		};
-
-		SDL_RenderCopyEx(
-			&renderer,
-			assetStore.GetTexture(sprite.assetId),
-			&sprite.srcRect,
-			&destRect,
-			transform.rotation,
-			nullptr,
-			sprite.flip);
+	queue.Sort();
+
+	spriteBatch.Begin(renderer);
+	queue.Submit(spriteBatch);
+	spriteBatch.End();
+
+	stats.drawCalls += spriteBatch.GetNumDrawCalls();
+	stats.textureSwitches += spriteBatch.GetNumTextureSwitches();
+}
+
+void RenderSystem::PushSprite(RenderQueue& queue, const Entity entity, const AssetStore& assetStore, const SDL_Rect& camera, const float renderAlpha, RenderStats& stats)
+{
+	const TransformComponent& transform = entity.GetComponent<TransformComponent>();
+	const SpriteComponent& sprite = entity.GetComponent<SpriteComponent>();
+
+	const glm::vec2 position = glm::mix(transform.previousPosition, transform.position, renderAlpha);
+	const int entityPosX = static_cast<int>(position.x) - (sprite.isFixed ? 0 : camera.x);
+	const int entityPosY = static_cast<int>(position.y) - (sprite.isFixed ? 0 : camera.y);
+	const int entityWidth = sprite.width * static_cast<int>(transform.scale.x);
+	const int entityHeight = sprite.height * static_cast<int>(transform.scale.y);
+
+	const bool isEntityOutOfCameraView = ((entityPosX + entityWidth) < 0) || (entityPosX > camera.w) || 
+										 ((entityPosY + entityHeight) < 0) || (entityPosY > camera.h);
+
+	++stats.spritesVisited;
+	if (isEntityOutOfCameraView) {
+		// Cull the sprites that are out of camera view.
+		assert(!sprite.isFixed);
+		++stats.spritesCulled;
+		return;
 	}
+
+	const SDL_FRect destRect = {
+		static_cast<float>(entityPosX),
+		static_cast<float>(entityPosY),
+		static_cast<float>(entityWidth),
+		static_cast<float>(entityHeight)
+	};
+
+	const TextureRegion& textureRegion = assetStore.GetTextureRegion(sprite.assetId);
+	const SDL_Rect srcRect = {
+		textureRegion.rect.x + sprite.srcRect.x,
+		textureRegion.rect.y + sprite.srcRect.y,
+		sprite.srcRect.w,
+		sprite.srcRect.h
+	};
+
+	queue.Push(
+		0 /* layer */,
+		sprite.zIndex,
+		textureRegion.texture,
+		srcRect,
+		destRect,
+		transform.rotation,
+		sprite.flip);
 }
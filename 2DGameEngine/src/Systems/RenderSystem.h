@@ -1,17 +1,68 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/SpriteBatch.h"
+#include "../Renderer/RenderQueue.h"
+#include "../Renderer/TileMap.h"
+#include "../Renderer/RenderStats.h"
+#include "../Utilities/SpatialGrid.h"
+
+#include <vector>
+#include <unordered_map>
 
 
 struct SDL_Renderer;
 struct SDL_Rect;
 class AssetStore;
 
+/**
+ * @brief Draws the sprites visible to the camera.
+ *
+ * Sprites of entities that cannot move (no rigidbody, no script, not fixed to the
+ * screen) are indexed in a grid when they are added, so only the cells around the
+ * camera are visited. They are assumed to keep their position. Other sprites are
+ * checked one by one.
+ *
+ * The static tile layer is not made of entities, it is drawn from the chunks of
+ * the tilemap, sorted together with the sprites at zIndex 0.
+ *
+ * Drawing is split in two: Record reads the entities into a render queue without
+ * calling SDL, Submit draws a recorded queue. With threaded rendering they run on
+ * the simulation and the main thread, Update does both.
+ *
+ * Moving sprites are drawn between their previous and current position by the
+ * render alpha, the fraction of the next simulation tick that already passed.
+ */
 class RenderSystem : public System
 {
 public:
 	RenderSystem();
 
-	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera);
+	virtual void AddEntityToSystem(const Entity entity) override;
+	virtual void RemoveEntityFromSystem(const Entity entity) override;
+
+	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha = 1.0f);
+
+	void Record(RenderQueue& queue, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats, const float renderAlpha = 1.0f) const;
+	void Submit(SDL_Renderer& renderer, const AssetStore& assetStore, RenderQueue& queue, const SDL_Rect& camera, RenderStats& stats);
+
+	void StorePreviousPositions();
+
+	inline TileMap& GetTileMap() { return tileMap; }
+
+	static bool IsStaticSprite(const Entity entity);
+
+private:
+	static void PushSprite(RenderQueue& queue, const Entity entity, const AssetStore& assetStore, const SDL_Rect& camera, const float renderAlpha, RenderStats& stats);
+
+private:
+	std::vector<Entity> movingSprites;
+	SpatialGrid<Entity> staticSpriteGrid;
+	std::unordered_map<unsigned, SpatialGrid<Entity>::CellKey> staticSpriteCellPerEntity;
+
+	TileMap tileMap;
+
+	RenderQueue renderQueue;
+	SpriteBatch spriteBatch;
 };
 
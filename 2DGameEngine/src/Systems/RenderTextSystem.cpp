@@ -13,32 +13,48 @@ RenderTextSystem::RenderTextSystem()
 
 }
 
-void RenderTextSystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera)
+void RenderTextSystem::Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats)
+{
+	drawCommands.clear();
+	Record(drawCommands, assetStore, camera);
+	Submit(renderer, drawCommands, stats);
+}
+
+void RenderTextSystem::Record(std::vector<TextDrawCommand>& commands, const AssetStore& assetStore, const SDL_Rect& camera)
 {
 	for (Entity entity : GetSystemEntities()) {
 		const TextLabelComponent& textLabel = entity.GetComponent<TextLabelComponent>();
 
-		SDL_Surface* surface = TTF_RenderText_Blended(assetStore.GetFont(textLabel.fontAssetId), textLabel.text.c_str(), textLabel.color);
-		SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
-		SDL_FreeSurface(surface);
-
 		const int textPosX = static_cast<int>(textLabel.position.x) - (textLabel.isFixed ? 0 : camera.x);
 		const int textPosY = static_cast<int>(textLabel.position.y) - (textLabel.isFixed ? 0 : camera.y);
 
-		int labelWidth = 0;
-		int labelHeight = 0;
-		SDL_QueryTexture(texture, nullptr, nullptr, &labelWidth, &labelHeight);
+		commands.push_back({ assetStore.GetFont(textLabel.fontAssetId), textLabel.text, textLabel.color, { textPosX, textPosY } });
+	}
+}
+
+void RenderTextSystem::Submit(SDL_Renderer& renderer, const std::vector<TextDrawCommand>& commands, RenderStats& stats)
+{
+	const unsigned numRasterizationsBefore = textCache.GetNumRasterizations();
+
+	for (const TextDrawCommand& command : commands) {
+		const TextTextureCache::CachedText& cachedText = textCache.GetText(renderer, command.font, command.text, command.color);
+		if (!cachedText.texture) {
+			continue;
+		}
 
 		const SDL_Rect destRect = {
-			textPosX,
-			textPosY,
-			labelWidth,
-			labelHeight
+			command.position.x,
+			command.position.y,
+			cachedText.width,
+			cachedText.height
 		};
 
-		SDL_RenderCopy(&renderer, texture, nullptr, &destRect);
+		SDL_RenderCopy(&renderer, cachedText.texture, nullptr, &destRect);
 
-		// Cleanup texture
-		SDL_DestroyTexture(texture);
+		// Every label has a texture of its own.
+		++stats.drawCalls;
+		++stats.textureSwitches;
 	}
+
+	stats.textRasterizations += textCache.GetNumRasterizations() - numRasterizationsBefore;
 }
@@ -1,18 +1,47 @@
 #pragma once
 
 #include "../ECS/ECS.h"
+#include "../Renderer/TextTextureCache.h"
+#include "../Renderer/RenderStats.h"
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <vector>
 
 struct SDL_Rect;
 struct SDL_Renderer;
 class AssetStore;
 
+/**
+ * @brief A text label to draw, in screen space.
+ */
+struct TextDrawCommand
+{
+	TTF_Font* font;
+	std::string text;
+	SDL_Color color;
+	SDL_Point position;
+};
+
+/**
+ * @brief Draws text labels. The texture of a label is only rendered again when its font, text or color changes.
+ *
+ * Like the RenderSystem, drawing can be split into Record and Submit.
+ */
 class RenderTextSystem : public System
 {
 public:
 	RenderTextSystem();
 
-	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera);
+	void Update(SDL_Renderer& renderer, const AssetStore& assetStore, const SDL_Rect& camera, RenderStats& stats);
+
+	void Record(std::vector<TextDrawCommand>& commands, const AssetStore& assetStore, const SDL_Rect& camera);
+	void Submit(SDL_Renderer& renderer, const std::vector<TextDrawCommand>& commands, RenderStats& stats);
 
+private:
+	TextTextureCache textCache;
+	std::vector<TextDrawCommand> drawCommands;
 };
 
 
@@ -0,0 +1,124 @@
+#include "AabbBatch.h"
+
+#include <limits>
+
+// Empty box used as padding, every comparison against it fails.
+const float PaddingMin = std::numeric_limits<float>::infinity();
+const float PaddingMax = -std::numeric_limits<float>::infinity();
+
+AabbBatch::AabbBatch()
+	: size(0)
+{
+}
+
+void AabbBatch::Clear()
+{
+	minX.clear();
+	minY.clear();
+	maxX.clear();
+	maxY.clear();
+	size = 0;
+}
+
+void AabbBatch::Reserve(const size_t numBoxes)
+{
+	const size_t paddedSize = (numBoxes + AABB_BATCH_WIDTH - 1) / AABB_BATCH_WIDTH * AABB_BATCH_WIDTH;
+	minX.reserve(paddedSize);
+	minY.reserve(paddedSize);
+	maxX.reserve(paddedSize);
+	maxY.reserve(paddedSize);
+}
+
+void AabbBatch::Add(const Aabb& aabb)
+{
+	if (size == minX.size()) {
+		minX.resize(size + AABB_BATCH_WIDTH, PaddingMin);
+		minY.resize(size + AABB_BATCH_WIDTH, PaddingMin);
+		maxX.resize(size + AABB_BATCH_WIDTH, PaddingMax);
+		maxY.resize(size + AABB_BATCH_WIDTH, PaddingMax);
+	}
+
+	minX[size] = aabb.min.x;
+	minY[size] = aabb.min.y;
+	maxX[size] = aabb.max.x;
+	maxY[size] = aabb.max.y;
+	++size;
+}
+
+unsigned AabbBatch::OverlapMask(const Aabb& aabb, const size_t first) const
+{
+	assert(first < size);
+
+#if defined(AABB_BATCH_AVX)
+	const __m256 queryMinX = _mm256_set1_ps(aabb.min.x);
+	const __m256 queryMinY = _mm256_set1_ps(aabb.min.y);
+	const __m256 queryMaxX = _mm256_set1_ps(aabb.max.x);
+	const __m256 queryMaxY = _mm256_set1_ps(aabb.max.y);
+
+	const __m256 overlapX = _mm256_and_ps(
+		_mm256_cmp_ps(_mm256_loadu_ps(&minX[first]), queryMaxX, _CMP_LE_OQ),
+		_mm256_cmp_ps(_mm256_loadu_ps(&maxX[first]), queryMinX, _CMP_GE_OQ));
+	const __m256 overlapY = _mm256_and_ps(
+		_mm256_cmp_ps(_mm256_loadu_ps(&minY[first]), queryMaxY, _CMP_LE_OQ),
+		_mm256_cmp_ps(_mm256_loadu_ps(&maxY[first]), queryMinY, _CMP_GE_OQ));
+
+	return static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY)));
+#elif defined(AABB_BATCH_SSE)
+	const __m128 queryMinX = _mm_set1_ps(aabb.min.x);
+	const __m128 queryMinY = _mm_set1_ps(aabb.min.y);
+	const __m128 queryMaxX = _mm_set1_ps(aabb.max.x);
+	const __m128 queryMaxY = _mm_set1_ps(aabb.max.y);
+
+	const __m128 overlapX = _mm_and_ps(
+		_mm_cmple_ps(_mm_loadu_ps(&minX[first]), queryMaxX),
+		_mm_cmpge_ps(_mm_loadu_ps(&maxX[first]), queryMinX));
+	const __m128 overlapY = _mm_and_ps(
+		_mm_cmple_ps(_mm_loadu_ps(&minY[first]), queryMaxY),
+		_mm_cmpge_ps(_mm_loadu_ps(&maxY[first]), queryMinY));
+
+	return static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+#else
+	unsigned hitMask = 0;
+	for (size_t lane = 0; lane < AABB_BATCH_WIDTH; ++lane) {
+		const size_t i = first + lane;
+		const bool overlaps = (minX[i] <= aabb.max.x) && (maxX[i] >= aabb.min.x) && (minY[i] <= aabb.max.y) && (maxY[i] >= aabb.min.y);
+		hitMask |= static_cast<unsigned>(overlaps) << lane;
+	}
+
+	return hitMask;
+#endif
+}
+
+unsigned AabbBatch::PairwiseOverlapMask(const AabbBatch& other, const size_t first) const
+{
+	assert(first < size && first < other.size);
+
+#if defined(AABB_BATCH_AVX)
+	const __m256 overlapX = _mm256_and_ps(
+		_mm256_cmp_ps(_mm256_loadu_ps(&minX[first]), _mm256_loadu_ps(&other.maxX[first]), _CMP_LE_OQ),
+		_mm256_cmp_ps(_mm256_loadu_ps(&maxX[first]), _mm256_loadu_ps(&other.minX[first]), _CMP_GE_OQ));
+	const __m256 overlapY = _mm256_and_ps(
+		_mm256_cmp_ps(_mm256_loadu_ps(&minY[first]), _mm256_loadu_ps(&other.maxY[first]), _CMP_LE_OQ),
+		_mm256_cmp_ps(_mm256_loadu_ps(&maxY[first]), _mm256_loadu_ps(&other.minY[first]), _CMP_GE_OQ));
+
+	return static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY)));
+#elif defined(AABB_BATCH_SSE)
+	const __m128 overlapX = _mm_and_ps(
+		_mm_cmple_ps(_mm_loadu_ps(&minX[first]), _mm_loadu_ps(&other.maxX[first])),
+		_mm_cmpge_ps(_mm_loadu_ps(&maxX[first]), _mm_loadu_ps(&other.minX[first])));
+	const __m128 overlapY = _mm_and_ps(
+		_mm_cmple_ps(_mm_loadu_ps(&minY[first]), _mm_loadu_ps(&other.maxY[first])),
+		_mm_cmpge_ps(_mm_loadu_ps(&maxY[first]), _mm_loadu_ps(&other.minY[first])));
+
+	return static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+#else
+	unsigned hitMask = 0;
+	for (size_t lane = 0; lane < AABB_BATCH_WIDTH; ++lane) {
+		const size_t i = first + lane;
+		const bool overlaps = (minX[i] <= other.maxX[i]) && (maxX[i] >= other.minX[i]) && (minY[i] <= other.maxY[i]) && (maxY[i] >= other.minY[i]);
+		hitMask |= static_cast<unsigned>(overlaps) << lane;
+	}
+
+	return hitMask;
+#endif
+}
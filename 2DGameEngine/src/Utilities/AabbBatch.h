@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <vector>
+
+#if defined(__AVX__)
+#define AABB_BATCH_AVX
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AABB_BATCH_SSE
+#include <emmintrin.h>
+#endif
+
+// Number of boxes tested by one mask call.
+#if defined(AABB_BATCH_AVX)
+const size_t AABB_BATCH_WIDTH = 8;
+#else
+const size_t AABB_BATCH_WIDTH = 4;
+#endif
+
+/**
+ * @brief Boxes stored as separate min/max coordinate arrays for SIMD overlap tests.
+ *
+ * The arrays are padded to a multiple of AABB_BATCH_WIDTH with empty boxes which
+ * never overlap anything, so a mask call may start at any index below GetSize().
+ * Uses AVX when the build enables it, else SSE, else plain loops.
+ */
+class AabbBatch
+{
+public:
+	AabbBatch();
+
+	void Clear();
+	void Reserve(const size_t numBoxes);
+	void Add(const Aabb& aabb);
+
+	inline size_t GetSize() const { return size; }
+	inline Aabb Get(const size_t index) const;
+
+	/**
+	 * @brief Tests the box against the AABB_BATCH_WIDTH boxes starting at @c first.
+	 * @return Bit i is set if box first + i overlaps.
+	 */
+	unsigned OverlapMask(const Aabb& aabb, const size_t first) const;
+
+	/**
+	 * @brief Tests box first + i of this batch against box first + i of the other batch.
+	 * @return Bit i is set if the two boxes overlap.
+	 */
+	unsigned PairwiseOverlapMask(const AabbBatch& other, const size_t first) const;
+
+	/**
+	 * @brief Calls callback(index) for every box overlapping the given box, in index order.
+	 */
+	template<typename TCallback>
+	void ForEachOverlap(const Aabb& aabb, TCallback&& callback) const;
+
+private:
+	std::vector<float> minX;
+	std::vector<float> minY;
+	std::vector<float> maxX;
+	std::vector<float> maxY;
+	size_t size;
+};
+
+
+Aabb AabbBatch::Get(const size_t index) const
+{
+	assert(index < size);
+	return Aabb(glm::vec2(minX[index], minY[index]), glm::vec2(maxX[index], maxY[index]));
+}
+
+template<typename TCallback>
+inline void AabbBatch::ForEachOverlap(const Aabb& aabb, TCallback&& callback) const
+{
+	for (size_t first = 0; first < size; first += AABB_BATCH_WIDTH) {
+		unsigned hitMask = OverlapMask(aabb, first);
+		for (size_t index = first; hitMask != 0; ++index, hitMask >>= 1) {
+			if (hitMask & 1) {
+				callback(index);
+			}
+		}
+	}
+}
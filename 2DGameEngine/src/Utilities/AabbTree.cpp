@@ -0,0 +1,356 @@
+#include "AabbTree.h"
+
+#include <assert.h>
+#include <algorithm>
+
+AabbTree::AabbTree(const float fatMargin)
+	: nodes()
+	, root(AABB_TREE_NULL_NODE)
+	, freeList(AABB_TREE_NULL_NODE)
+	, fatMargin(fatMargin)
+	, queryStack()
+{
+	queryStack.reserve(256);
+}
+
+int AabbTree::CreateProxy(const Aabb& aabb, const unsigned userData)
+{
+	const int proxyId = AllocateNode();
+
+	Node& node = nodes[proxyId];
+	node.aabb = aabb.Expand(fatMargin);
+	node.userData = userData;
+	node.height = 0;
+
+	InsertLeaf(proxyId);
+
+	return proxyId;
+}
+
+void AabbTree::DestroyProxy(const int proxyId)
+{
+	assert(0 <= proxyId && proxyId < static_cast<int>(nodes.size()));
+	assert(nodes[proxyId].IsLeaf());
+
+	RemoveLeaf(proxyId);
+	FreeNode(proxyId);
+}
+
+bool AabbTree::MoveProxy(const int proxyId, const Aabb& aabb)
+{
+	assert(0 <= proxyId && proxyId < static_cast<int>(nodes.size()));
+	assert(nodes[proxyId].IsLeaf());
+
+	if (nodes[proxyId].aabb.Contains(aabb)) {
+		return false;
+	}
+
+	RemoveLeaf(proxyId);
+	nodes[proxyId].aabb = aabb.Expand(fatMargin);
+	InsertLeaf(proxyId);
+
+	return true;
+}
+
+void AabbTree::Build(const std::vector<Aabb>& aabbs, const std::vector<unsigned>& userData, std::vector<int>& outProxyIds)
+{
+	assert(aabbs.size() == userData.size());
+
+	Clear();
+	nodes.reserve(2 * aabbs.size());
+	outProxyIds.resize(aabbs.size());
+
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		const int proxyId = AllocateNode();
+		nodes[proxyId].aabb = aabbs[i].Expand(fatMargin);
+		nodes[proxyId].userData = userData[i];
+		nodes[proxyId].height = 0;
+		outProxyIds[i] = proxyId;
+	}
+
+	if (aabbs.empty()) {
+		return;
+	}
+
+	std::vector<int> leaves(outProxyIds);
+	root = BuildRecursive(leaves.data(), leaves.data() + leaves.size());
+	nodes[root].parent = AABB_TREE_NULL_NODE;
+}
+
+void AabbTree::Clear()
+{
+	nodes.clear();
+	root = AABB_TREE_NULL_NODE;
+	freeList = AABB_TREE_NULL_NODE;
+}
+
+int AabbTree::GetHeight() const
+{
+	return root != AABB_TREE_NULL_NODE ? nodes[root].height : 0;
+}
+
+int AabbTree::AllocateNode()
+{
+	if (freeList == AABB_TREE_NULL_NODE) {
+		nodes.emplace_back();
+		return static_cast<int>(nodes.size()) - 1;
+	}
+
+	const int nodeId = freeList;
+	freeList = nodes[nodeId].parent;
+	nodes[nodeId] = Node();
+	return nodeId;
+}
+
+void AabbTree::FreeNode(const int nodeId)
+{
+	nodes[nodeId].parent = freeList;
+	nodes[nodeId].height = -1;
+	freeList = nodeId;
+}
+
+/**
+ * @brief Inserts the leaf next to the sibling that causes the least perimeter growth.
+ */
+void AabbTree::InsertLeaf(const int leaf)
+{
+	if (root == AABB_TREE_NULL_NODE) {
+		root = leaf;
+		nodes[root].parent = AABB_TREE_NULL_NODE;
+		return;
+	}
+
+	// Find the best sibling for the new leaf.
+
+	const Aabb leafAabb = nodes[leaf].aabb;
+	int index = root;
+	while (!nodes[index].IsLeaf()) {
+		const Node& node = nodes[index];
+		const float area = node.aabb.GetPerimeter();
+		const float combinedArea = node.aabb.Merge(leafAabb).GetPerimeter();
+
+		// Cost of creating a new parent for this node and the new leaf.
+		const float cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down the tree.
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](const int childId) {
+			const Node& child = nodes[childId];
+			const float mergedArea = child.aabb.Merge(leafAabb).GetPerimeter();
+			return child.IsLeaf() ? mergedArea + inheritanceCost
+								  : (mergedArea - child.aabb.GetPerimeter()) + inheritanceCost;
+		};
+
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+
+		index = (cost1 < cost2) ? node.child1 : node.child2;
+	}
+
+	const int sibling = index;
+
+	// Create a new parent for the sibling and the leaf.
+
+	const int oldParent = nodes[sibling].parent;
+	const int newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].aabb = leafAabb.Merge(nodes[sibling].aabb);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent != AABB_TREE_NULL_NODE) {
+		if (nodes[oldParent].child1 == sibling) {
+			nodes[oldParent].child1 = newParent;
+		}
+		else {
+			nodes[oldParent].child2 = newParent;
+		}
+	}
+	else {
+		root = newParent;
+	}
+
+	// Walk back up the tree fixing heights and boxes.
+
+	index = nodes[leaf].parent;
+	while (index != AABB_TREE_NULL_NODE) {
+		index = Balance(index);
+
+		Node& node = nodes[index];
+		const Node& child1 = nodes[node.child1];
+		const Node& child2 = nodes[node.child2];
+		node.height = 1 + glm::max(child1.height, child2.height);
+		node.aabb = child1.aabb.Merge(child2.aabb);
+
+		index = node.parent;
+	}
+}
+
+void AabbTree::RemoveLeaf(const int leaf)
+{
+	if (leaf == root) {
+		root = AABB_TREE_NULL_NODE;
+		return;
+	}
+
+	const int parent = nodes[leaf].parent;
+	const int grandParent = nodes[parent].parent;
+	const int sibling = (nodes[parent].child1 == leaf) ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent == AABB_TREE_NULL_NODE) {
+		root = sibling;
+		nodes[sibling].parent = AABB_TREE_NULL_NODE;
+		FreeNode(parent);
+		return;
+	}
+
+	// Destroy the parent and connect the sibling to the grand parent.
+	if (nodes[grandParent].child1 == parent) {
+		nodes[grandParent].child1 = sibling;
+	}
+	else {
+		nodes[grandParent].child2 = sibling;
+	}
+	nodes[sibling].parent = grandParent;
+	FreeNode(parent);
+
+	int index = grandParent;
+	while (index != AABB_TREE_NULL_NODE) {
+		index = Balance(index);
+
+		Node& node = nodes[index];
+		const Node& child1 = nodes[node.child1];
+		const Node& child2 = nodes[node.child2];
+		node.aabb = child1.aabb.Merge(child2.aabb);
+		node.height = 1 + glm::max(child1.height, child2.height);
+
+		index = node.parent;
+	}
+}
+
+/**
+ * @brief Splits the leaves at the median of their centers along the longer axis.
+ * @return Index of the subtree root.
+ */
+int AabbTree::BuildRecursive(int* first, int* last)
+{
+	const size_t count = static_cast<size_t>(last - first);
+	if (count == 1) {
+		return *first;
+	}
+
+	auto getCenter = [this](const int nodeId) {
+		const Aabb& aabb = nodes[nodeId].aabb;
+		return (aabb.min + aabb.max) * 0.5f;
+	};
+
+	Aabb centerBounds(getCenter(*first), getCenter(*first));
+	for (int* leaf = first + 1; leaf != last; ++leaf) {
+		const glm::vec2 center = getCenter(*leaf);
+		centerBounds = centerBounds.Merge(Aabb(center, center));
+	}
+
+	const int axis = (centerBounds.GetWidth() >= centerBounds.GetHeight()) ? 0 : 1;
+	int* middle = first + count / 2;
+	std::nth_element(first, middle, last, [&](const int a, const int b) {
+		return getCenter(a)[axis] < getCenter(b)[axis];
+	});
+
+	const int child1 = BuildRecursive(first, middle);
+	const int child2 = BuildRecursive(middle, last);
+
+	const int parent = AllocateNode();
+	nodes[parent].child1 = child1;
+	nodes[parent].child2 = child2;
+	nodes[parent].aabb = nodes[child1].aabb.Merge(nodes[child2].aabb);
+	nodes[parent].height = 1 + glm::max(nodes[child1].height, nodes[child2].height);
+	nodes[child1].parent = parent;
+	nodes[child2].parent = parent;
+
+	return parent;
+}
+
+/**
+ * @brief Performs a left or right rotation if the node is imbalanced.
+ * @return Index of the node that took the place of the given node.
+ */
+int AabbTree::Balance(const int iA)
+{
+	Node& A = nodes[iA];
+	if (A.IsLeaf() || A.height < 2) {
+		return iA;
+	}
+
+	const int iB = A.child1;
+	const int iC = A.child2;
+	Node& B = nodes[iB];
+	Node& C = nodes[iC];
+
+	const int balance = C.height - B.height;
+
+	// Rotates the higher child up, hanging A under it.
+	auto rotate = [&](const int iUp, const int iOther, const bool upIsChild2) {
+		Node& up = nodes[iUp];
+		const int iF = up.child1;
+		const int iG = up.child2;
+		Node& F = nodes[iF];
+		Node& G = nodes[iG];
+		Node& other = nodes[iOther];
+
+		up.child1 = iA;
+		up.parent = A.parent;
+		A.parent = iUp;
+
+		if (up.parent != AABB_TREE_NULL_NODE) {
+			if (nodes[up.parent].child1 == iA) {
+				nodes[up.parent].child1 = iUp;
+			}
+			else {
+				nodes[up.parent].child2 = iUp;
+			}
+		}
+		else {
+			root = iUp;
+		}
+
+		// Keep the taller grandchild under the rotated node, hand the other one to A.
+		const bool keepF = F.height > G.height;
+		const int iKeep = keepF ? iF : iG;
+		const int iGive = keepF ? iG : iF;
+
+		up.child2 = iKeep;
+		if (upIsChild2) {
+			A.child2 = iGive;
+		}
+		else {
+			A.child1 = iGive;
+		}
+		nodes[iGive].parent = iA;
+
+		A.aabb = other.aabb.Merge(nodes[iGive].aabb);
+		A.height = 1 + glm::max(other.height, nodes[iGive].height);
+
+		up.aabb = A.aabb.Merge(nodes[iKeep].aabb);
+		up.height = 1 + glm::max(A.height, nodes[iKeep].height);
+
+		return iUp;
+	};
+
+	if (balance > 1) {
+		return rotate(iC, iB, true);
+	}
+
+	if (balance < -1) {
+		return rotate(iB, iC, false);
+	}
+
+	return iA;
+}
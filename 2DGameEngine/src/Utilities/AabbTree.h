@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "../Math/Intersection.h"
+
+const int AABB_TREE_NULL_NODE = -1;
+
+/**
+ * @brief Incrementally updated bounding volume hierarchy.
+ *
+ * Every leaf is a proxy that stores a fattened box of its object and a user value
+ * (e.g. entity id). Small movements inside the fat box do not touch the tree,
+ * larger ones reinsert the leaf. The tree is kept balanced with AVL like rotations.
+ */
+class AabbTree
+{
+public:
+	AabbTree(const float fatMargin = 4.0f);
+
+	int CreateProxy(const Aabb& aabb, const unsigned userData);
+	void DestroyProxy(const int proxyId);
+
+	/**
+	 * @brief Refits the proxy to the new box.
+	 * @return @c true if the proxy was reinserted, @c false if it still fits into its fat box.
+	 */
+	bool MoveProxy(const int proxyId, const Aabb& aabb);
+
+	/**
+	 * @brief Replaces the content of the tree with the given boxes, built top-down.
+	 *
+	 * Gives a better tree than inserting the boxes one by one, use it for sets
+	 * that are known up front. The tree can still be updated incrementally afterwards.
+	 */
+	void Build(const std::vector<Aabb>& aabbs, const std::vector<unsigned>& userData, std::vector<int>& outProxyIds);
+
+	void Clear();
+
+	inline unsigned GetUserData(const int proxyId) const;
+	inline void SetUserData(const int proxyId, const unsigned userData);
+	inline const Aabb& GetFatAabb(const int proxyId) const;
+	inline bool IsEmpty() const;
+	int GetHeight() const;
+
+	/**
+	 * @brief Calls callback(proxyId) for every proxy whose fat box overlaps the given box.
+	 * Return @c false from the callback to stop the query.
+	 */
+	template<typename TCallback>
+	void QueryAabb(const Aabb& aabb, TCallback&& callback) const;
+
+	template<typename TCallback>
+	void QueryPoint(const glm::vec2& point, TCallback&& callback) const;
+
+	/**
+	 * @brief Casts the segment p0 -> p1 through the tree.
+	 *
+	 * callback(proxyId, maxFraction) must return the fraction to clip the ray to:
+	 * 0 terminates the cast, maxFraction ignores the proxy, anything in between shortens the ray.
+	 */
+	template<typename TCallback>
+	void Raycast(const glm::vec2& p0, const glm::vec2& p1, TCallback&& callback) const;
+
+private:
+	struct Node
+	{
+		inline bool IsLeaf() const { return child1 == AABB_TREE_NULL_NODE; }
+
+		Aabb aabb;
+		unsigned userData = 0;
+
+		// Parent index while in the tree, next free node while in the free list.
+		int parent = AABB_TREE_NULL_NODE;
+		int child1 = AABB_TREE_NULL_NODE;
+		int child2 = AABB_TREE_NULL_NODE;
+
+		// Leaf = 0, free node = -1
+		int height = -1;
+	};
+
+	int AllocateNode();
+	void FreeNode(const int nodeId);
+
+	void InsertLeaf(const int leaf);
+	void RemoveLeaf(const int leaf);
+	int Balance(const int nodeId);
+	int BuildRecursive(int* first, int* last);
+
+private:
+	std::vector<Node> nodes;
+	int root;
+	int freeList;
+	float fatMargin;
+
+	// Scratch stack reused by the queries.
+	mutable std::vector<int> queryStack;
+};
+
+
+unsigned AabbTree::GetUserData(const int proxyId) const
+{
+	return nodes[proxyId].userData;
+}
+
+void AabbTree::SetUserData(const int proxyId, const unsigned userData)
+{
+	nodes[proxyId].userData = userData;
+}
+
+const Aabb& AabbTree::GetFatAabb(const int proxyId) const
+{
+	return nodes[proxyId].aabb;
+}
+
+bool AabbTree::IsEmpty() const
+{
+	return root == AABB_TREE_NULL_NODE;
+}
+
+template<typename TCallback>
+inline void AabbTree::QueryAabb(const Aabb& aabb, TCallback&& callback) const
+{
+	if (root == AABB_TREE_NULL_NODE) {
+		return;
+	}
+
+	// Borrow the scratch stack, nested queries from callbacks allocate their own.
+	std::vector<int> stack;
+	stack.swap(queryStack);
+	stack.clear();
+	stack.push_back(root);
+
+	while (!stack.empty()) {
+		const int nodeId = stack.back();
+		const Node& node = nodes[nodeId];
+		stack.pop_back();
+
+		if (!node.aabb.Overlaps(aabb)) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			if (!callback(nodeId)) {
+				break;
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+
+	stack.swap(queryStack);
+}
+
+template<typename TCallback>
+inline void AabbTree::QueryPoint(const glm::vec2& point, TCallback&& callback) const
+{
+	QueryAabb(Aabb(point, point), std::forward<TCallback>(callback));
+}
+
+template<typename TCallback>
+inline void AabbTree::Raycast(const glm::vec2& p0, const glm::vec2& p1, TCallback&& callback) const
+{
+	if (root == AABB_TREE_NULL_NODE) {
+		return;
+	}
+
+	float maxFraction = 1.0f;
+
+	std::vector<int> stack;
+	stack.swap(queryStack);
+	stack.clear();
+	stack.push_back(root);
+
+	while (!stack.empty()) {
+		const int nodeId = stack.back();
+		const Node& node = nodes[nodeId];
+		stack.pop_back();
+
+		const glm::vec2 rayEnd = p0 + (p1 - p0) * maxFraction;
+		float fraction = 0.0f;
+		if (!findIntersection(fraction, p0, rayEnd, node.aabb)) {
+			continue;
+		}
+
+		if (node.IsLeaf()) {
+			const float newFraction = callback(nodeId, maxFraction);
+			if (newFraction == 0.0f) {
+				break;
+			}
+
+			maxFraction = glm::min(maxFraction, newFraction);
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+
+	stack.swap(queryStack);
+}
@@ -0,0 +1,52 @@
+#include "CollisionMatrix.h"
+
+#include <utility>
+
+const std::pair<const char*, CollisionLayer> collisionLayerNames[] = {
+	{ "default", CollisionLayer::LAYER_default },
+	{ "player", CollisionLayer::LAYER_player },
+	{ "enemy", CollisionLayer::LAYER_enemy },
+	{ "projectile", CollisionLayer::LAYER_projectile },
+	{ "obstacle", CollisionLayer::LAYER_obstacle },
+	{ "tile", CollisionLayer::LAYER_tile },
+};
+
+/**
+ * @brief Creates a matrix where every layer collides with every other layer.
+ */
+CollisionMatrix::CollisionMatrix()
+{
+	masks.fill(COLLISION_MASK_ALL);
+}
+
+void CollisionMatrix::SetCollides(const CollisionLayer a, const CollisionLayer b, const bool collides)
+{
+	CollisionMask& maskA = masks[static_cast<size_t>(a)];
+	CollisionMask& maskB = masks[static_cast<size_t>(b)];
+
+	if (collides) {
+		maskA |= GetLayerBit(b);
+		maskB |= GetLayerBit(a);
+	}
+	else {
+		maskA &= ~GetLayerBit(b);
+		maskB &= ~GetLayerBit(a);
+	}
+}
+
+bool CollisionMatrix::Collides(const CollisionLayer a, const CollisionLayer b) const
+{
+	return (GetMask(a) & GetLayerBit(b)) != 0;
+}
+
+bool CollisionMatrix::GetLayerByName(const std::string& name, CollisionLayer& outLayer)
+{
+	for (const auto& layerName : collisionLayerNames) {
+		if (name == layerName.first) {
+			outLayer = layerName.second;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../Components/BoxColliderComponent.h"
+
+#include <array>
+#include <string>
+
+/**
+ * @brief Symmetric table of which collision layers interact with each other.
+ *
+ * Each layer row is stored as a bit mask, so a pair can be rejected with
+ * a single AND against the other layer's bit.
+ */
+class CollisionMatrix
+{
+public:
+	CollisionMatrix();
+
+	void SetCollides(const CollisionLayer a, const CollisionLayer b, const bool collides);
+	bool Collides(const CollisionLayer a, const CollisionLayer b) const;
+
+	inline CollisionMask GetMask(const CollisionLayer layer) const;
+
+	static inline CollisionMask GetLayerBit(const CollisionLayer layer);
+	static bool GetLayerByName(const std::string& name, CollisionLayer& outLayer);
+
+private:
+	static const size_t NUM_LAYERS = static_cast<size_t>(CollisionLayer::LAYER_count);
+
+	std::array<CollisionMask, NUM_LAYERS> masks;
+};
+
+
+CollisionMask CollisionMatrix::GetMask(const CollisionLayer layer) const
+{
+	return masks[static_cast<size_t>(layer)];
+}
+
+CollisionMask CollisionMatrix::GetLayerBit(const CollisionLayer layer)
+{
+	return CollisionMask(1) << static_cast<unsigned>(layer);
+}
@@ -0,0 +1,138 @@
+#include "FramePacer.h"
+
+#include <cmath>
+
+FramePacer::FramePacer()
+	: mode(FramePacingMode::PACING_uncapped)
+	, framePeriod(0)
+	, lastFrameStart(0)
+	, nextFrameDeadline(0)
+	, histogram()
+	, numFrames(0)
+	, totalFrameTimeMs(0.0)
+	, maxFrameTimeMs(0.0)
+	, lastFrameTimeMs(0.0)
+	, totalJitterMs(0.0)
+{
+}
+
+void FramePacer::Reset(const FramePacingMode mode, const unsigned targetFps)
+{
+	this->mode = mode;
+	framePeriod = targetFps > 0 ? SDL_GetPerformanceFrequency() / targetFps : 0;
+	if (framePeriod == 0 && mode == FramePacingMode::PACING_fixed) {
+		this->mode = FramePacingMode::PACING_uncapped;
+	}
+
+	lastFrameStart = 0;
+	nextFrameDeadline = 0;
+	ClearStats();
+}
+
+double FramePacer::BeginFrame()
+{
+	if (mode == FramePacingMode::PACING_fixed && lastFrameStart != 0) {
+		WaitUntil(nextFrameDeadline);
+	}
+
+	const Uint64 now = SDL_GetPerformanceCounter();
+	if (lastFrameStart == 0) {
+		lastFrameStart = now;
+		nextFrameDeadline = now + framePeriod;
+		return 0.0;
+	}
+
+	const double frameTimeMs = 1000.0 * (now - lastFrameStart) / SDL_GetPerformanceFrequency();
+	lastFrameStart = now;
+
+	nextFrameDeadline += framePeriod;
+	if (now >= nextFrameDeadline) {
+		nextFrameDeadline = now + framePeriod;
+	}
+
+	RecordFrameTime(frameTimeMs);
+	return frameTimeMs;
+}
+
+/**
+ * @brief Sleeps in whole milliseconds while the deadline is far, then spins on the counter.
+ */
+void FramePacer::WaitUntil(const Uint64 deadline) const
+{
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	const Uint64 spinTicks = static_cast<Uint64>(frequency * FRAME_PACER_SPIN_MS / 1000.0);
+
+	Uint64 now = SDL_GetPerformanceCounter();
+	while (now < deadline) {
+		const Uint64 remaining = deadline - now;
+		if (remaining > spinTicks) {
+			SDL_Delay(static_cast<Uint32>((remaining - spinTicks) * 1000 / frequency));
+		}
+
+		now = SDL_GetPerformanceCounter();
+	}
+}
+
+void FramePacer::RecordFrameTime(const double frameTimeMs)
+{
+	const size_t lastBucket = histogram.size() - 1;
+	const size_t bucket = static_cast<size_t>(frameTimeMs * FRAME_HISTOGRAM_BUCKETS_PER_MS);
+	++histogram[bucket < lastBucket ? bucket : lastBucket];
+
+	if (numFrames > 0) {
+		totalJitterMs += std::fabs(frameTimeMs - lastFrameTimeMs);
+	}
+
+	++numFrames;
+	totalFrameTimeMs += frameTimeMs;
+	lastFrameTimeMs = frameTimeMs;
+	if (frameTimeMs > maxFrameTimeMs) {
+		maxFrameTimeMs = frameTimeMs;
+	}
+}
+
+/**
+ * @brief Upper edge of the histogram bucket holding the frame at the fraction, accurate to one bucket.
+ */
+double FramePacer::GetPercentile(const double fraction) const
+{
+	const unsigned rank = static_cast<unsigned>(std::ceil(fraction * numFrames));
+
+	unsigned count = 0;
+	for (size_t bucket = 0; bucket + 1 < histogram.size(); ++bucket) {
+		count += histogram[bucket];
+		if (count >= rank) {
+			const double bucketEndMs = static_cast<double>(bucket + 1) / FRAME_HISTOGRAM_BUCKETS_PER_MS;
+			return bucketEndMs < maxFrameTimeMs ? bucketEndMs : maxFrameTimeMs;
+		}
+	}
+
+	return maxFrameTimeMs;
+}
+
+FrameTimeStats FramePacer::GetStats() const
+{
+	FrameTimeStats stats = {};
+	if (numFrames == 0) {
+		return stats;
+	}
+
+	stats.numFrames = numFrames;
+	stats.averageMs = totalFrameTimeMs / numFrames;
+	stats.p50Ms = GetPercentile(0.50);
+	stats.p90Ms = GetPercentile(0.90);
+	stats.p99Ms = GetPercentile(0.99);
+	stats.maxMs = maxFrameTimeMs;
+	stats.jitterMs = numFrames > 1 ? totalJitterMs / (numFrames - 1) : 0.0;
+	return stats;
+}
+
+void FramePacer::ClearStats()
+{
+	histogram.fill(0);
+	numFrames = 0;
+	totalFrameTimeMs = 0.0;
+	maxFrameTimeMs = 0.0;
+	lastFrameTimeMs = 0.0;
+	totalJitterMs = 0.0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include <array>
+
+enum class FramePacingMode
+{
+	PACING_fixed,
+	PACING_vsync,
+	PACING_uncapped,
+};
+
+// Frame time histogram resolution, frames longer than the last bucket share it.
+const unsigned FRAME_HISTOGRAM_BUCKETS_PER_MS = 10;
+const unsigned FRAME_HISTOGRAM_MAX_MS = 100;
+
+// Waits shorter than this are spun instead of slept, SDL_Delay may oversleep by about as much.
+const double FRAME_PACER_SPIN_MS = 2.0;
+
+struct FrameTimeStats
+{
+	unsigned numFrames;
+	double averageMs;
+	double p50Ms;
+	double p90Ms;
+	double p99Ms;
+	double maxMs;
+
+	// Average change of the frame time from one frame to the next.
+	double jitterMs;
+};
+
+/**
+ * @brief Starts the frames on time, measured by the performance counter, and keeps a histogram of the frame times.
+ *
+ * In fixed mode frames are due every 1 / targetFps seconds. Deadlines advance by
+ * whole periods, so an early or late frame does not shift the ones after it; only
+ * after falling more than a frame behind the schedule restarts. In vsync mode the
+ * renderer waits in present and the pacer only measures, uncapped frames start as
+ * soon as the previous one is done.
+ */
+class FramePacer
+{
+public:
+	FramePacer();
+
+	void Reset(const FramePacingMode mode, const unsigned targetFps);
+
+	/**
+	 * @brief Waits until the next frame is due, in fixed mode.
+	 * @return Time since the previous frame began, in milliseconds. 0 for the first frame.
+	 */
+	double BeginFrame();
+
+	FrameTimeStats GetStats() const;
+	void ClearStats();
+
+	inline FramePacingMode GetMode() const { return mode; }
+
+private:
+	void WaitUntil(const Uint64 deadline) const;
+	void RecordFrameTime(const double frameTimeMs);
+	double GetPercentile(const double fraction) const;
+
+private:
+	FramePacingMode mode;
+	Uint64 framePeriod;
+	Uint64 lastFrameStart;
+	Uint64 nextFrameDeadline;
+
+	std::array<unsigned, FRAME_HISTOGRAM_BUCKETS_PER_MS * FRAME_HISTOGRAM_MAX_MS + 1> histogram;
+	unsigned numFrames;
+	double totalFrameTimeMs;
+	double maxFrameTimeMs;
+	double lastFrameTimeMs;
+	double totalJitterMs;
+};
@@ -1,15 +1,11 @@
 #include "Geometry.h"
 
-Aabb::Aabb(const glm::vec2& min, const glm::vec2& max)
-	: min(min)
-	, max(max)
-{
-	assert(glm::all(glm::lessThanEqual(min, max)));
-}
+#include <cmath>
 
-bool Aabb::Overlaps(const Aabb& aabb) const
+Aabb::Aabb()
+	: min(0.0f)
+	, max(0.0f)
 {
-	return glm::all(glm::lessThanEqual(min, aabb.max)) && glm::all(glm::greaterThanEqual(max, aabb.min));
 }
 
 bool Aabb::Contains(const glm::vec2 pos) const
@@ -17,12 +13,66 @@ bool Aabb::Contains(const glm::vec2 pos) const
 	return glm::all(glm::lessThanEqual(min, pos)) && glm::all(glm::greaterThanEqual(max, pos));
 }
 
-float Aabb::GetWidth() const
+bool Aabb::Contains(const Aabb& aabb) const
+{
+	return glm::all(glm::lessThanEqual(min, aabb.min)) && glm::all(glm::greaterThanEqual(max, aabb.max));
+}
+
+float Aabb::GetPerimeter() const
+{
+	return 2.0f * (GetWidth() + GetHeight());
+}
+
+Aabb Aabb::Merge(const Aabb& aabb) const
+{
+	return Aabb(glm::min(min, aabb.min), glm::max(max, aabb.max));
+}
+
+Aabb Aabb::Expand(const float margin) const
+{
+	return Aabb(min - glm::vec2(margin), max + glm::vec2(margin));
+}
+
+Circle::Circle()
+	: center(0.0f)
+	, radius(0.0f)
+{
+}
+
+Circle::Circle(const glm::vec2& center, const float radius)
+	: center(center)
+	, radius(radius)
+{
+	assert(radius >= 0.0f);
+}
+
+Aabb Circle::GetAabb() const
+{
+	return Aabb(center - glm::vec2(radius), center + glm::vec2(radius));
+}
+
+Obb::Obb()
+	: center(0.0f)
+	, halfExtents(0.0f)
+	, axisX(1.0f, 0.0f)
+	, axisY(0.0f, 1.0f)
+{
+}
+
+/**
+ * @param rotationRadians Clockwise on screen, as the y axis points down.
+ */
+Obb::Obb(const glm::vec2& center, const glm::vec2& halfExtents, const float rotationRadians)
+	: center(center)
+	, halfExtents(halfExtents)
+	, axisX(std::cos(rotationRadians), std::sin(rotationRadians))
+	, axisY(-std::sin(rotationRadians), std::cos(rotationRadians))
 {
-	return max.x - min.x;
+	assert(halfExtents.x >= 0.0f && halfExtents.y >= 0.0f);
 }
 
-float Aabb::GetHeight() const
+Aabb Obb::GetAabb() const
 {
-	return max.y - min.y;
+	const glm::vec2 extents = glm::abs(axisX) * halfExtents.x + glm::abs(axisY) * halfExtents.y;
+	return Aabb(center - extents, center + extents);
 }
\ No newline at end of file
@@ -5,12 +5,68 @@
 
 struct Aabb
 {
-	Aabb(const glm::vec2& min, const glm::vec2& max);
-	bool Overlaps(const Aabb& aabb) const;
+	Aabb();
+	inline Aabb(const glm::vec2& min, const glm::vec2& max);
+	inline bool Overlaps(const Aabb& aabb) const;
 	bool Contains(const glm::vec2 pos) const;
-	float GetWidth() const;
-	float GetHeight() const;
+	bool Contains(const Aabb& aabb) const;
+	inline float GetWidth() const;
+	inline float GetHeight() const;
+	float GetPerimeter() const;
+
+	Aabb Merge(const Aabb& aabb) const;
+	Aabb Expand(const float margin) const;
 
 	glm::vec2 min;
 	glm::vec2 max;
-};
\ No newline at end of file
+};
+
+struct Circle
+{
+	Circle();
+	Circle(const glm::vec2& center, const float radius);
+	Aabb GetAabb() const;
+
+	glm::vec2 center;
+	float radius;
+};
+
+/**
+ * @brief Box rotated around its center. The axes are unit vectors.
+ */
+struct Obb
+{
+	Obb();
+	Obb(const glm::vec2& center, const glm::vec2& halfExtents, const float rotationRadians);
+	Aabb GetAabb() const;
+
+	glm::vec2 center;
+	glm::vec2 halfExtents;
+	glm::vec2 axisX;
+	glm::vec2 axisY;
+};
+
+
+// Hot in the collision loops, kept inline.
+
+Aabb::Aabb(const glm::vec2& min, const glm::vec2& max)
+	: min(min)
+	, max(max)
+{
+	assert(min.x <= max.x && min.y <= max.y);
+}
+
+bool Aabb::Overlaps(const Aabb& aabb) const
+{
+	return (min.x <= aabb.max.x) && (max.x >= aabb.min.x) && (min.y <= aabb.max.y) && (max.y >= aabb.min.y);
+}
+
+float Aabb::GetWidth() const
+{
+	return max.x - min.x;
+}
+
+float Aabb::GetHeight() const
+{
+	return max.y - min.y;
+}
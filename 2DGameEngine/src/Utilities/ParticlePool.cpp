@@ -0,0 +1,164 @@
+#include "ParticlePool.h"
+
+static inline Uint8 LerpChannel(const Uint8 from, const Uint8 to, const float t)
+{
+	return static_cast<Uint8>(from + (static_cast<float>(to) - from) * t);
+}
+
+ParticlePool::ParticlePool(const size_t maxSize)
+	: size(0)
+	, maxSize(maxSize)
+{
+}
+
+void ParticlePool::Clear()
+{
+	size = 0;
+}
+
+bool ParticlePool::Spawn(const ParticleSpawn& spawn)
+{
+	if (size >= maxSize) {
+		return false;
+	}
+
+	if (size == positionX.size()) {
+		// Grow by whole SIMD steps, so Integrate never reads past the arrays.
+		const size_t newSize = size + PARTICLE_POOL_WIDTH;
+		positionX.resize(newSize, 0.0f);
+		positionY.resize(newSize, 0.0f);
+		velocityX.resize(newSize, 0.0f);
+		velocityY.resize(newSize, 0.0f);
+		accelerationX.resize(newSize, 0.0f);
+		accelerationY.resize(newSize, 0.0f);
+		age.resize(newSize, 0.0f);
+		ageRate.resize(newSize, 0.0f);
+		startSize.resize(newSize, 0.0f);
+		endSize.resize(newSize, 0.0f);
+		startColor.resize(newSize);
+		endColor.resize(newSize);
+	}
+
+	positionX[size] = spawn.position.x;
+	positionY[size] = spawn.position.y;
+	velocityX[size] = spawn.velocity.x;
+	velocityY[size] = spawn.velocity.y;
+	accelerationX[size] = spawn.acceleration.x;
+	accelerationY[size] = spawn.acceleration.y;
+	age[size] = 0.0f;
+	ageRate[size] = spawn.lifetimeS > 0.0f ? 1.0f / spawn.lifetimeS : 1.0e6f;
+	startSize[size] = spawn.startSize;
+	endSize[size] = spawn.endSize;
+	startColor[size] = spawn.startColor;
+	endColor[size] = spawn.endColor;
+	++size;
+
+	return true;
+}
+
+void ParticlePool::Update(const float deltaTimeSec)
+{
+	Integrate(deltaTimeSec);
+	RemoveExpired();
+}
+
+/**
+ * @brief Semi-implicit Euler step of all particles, including the padding after the last one.
+ */
+void ParticlePool::Integrate(const float deltaTimeSec)
+{
+#if defined(PARTICLE_POOL_SSE)
+	const __m128 deltaTime = _mm_set1_ps(deltaTimeSec);
+	for (size_t i = 0; i < size; i += PARTICLE_POOL_WIDTH) {
+		const __m128 newVelocityX = _mm_add_ps(_mm_loadu_ps(&velocityX[i]), _mm_mul_ps(_mm_loadu_ps(&accelerationX[i]), deltaTime));
+		const __m128 newVelocityY = _mm_add_ps(_mm_loadu_ps(&velocityY[i]), _mm_mul_ps(_mm_loadu_ps(&accelerationY[i]), deltaTime));
+		_mm_storeu_ps(&velocityX[i], newVelocityX);
+		_mm_storeu_ps(&velocityY[i], newVelocityY);
+
+		_mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(newVelocityX, deltaTime)));
+		_mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(newVelocityY, deltaTime)));
+
+		_mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), _mm_mul_ps(_mm_loadu_ps(&ageRate[i]), deltaTime)));
+	}
+#else
+	for (size_t i = 0; i < size; ++i) {
+		velocityX[i] += accelerationX[i] * deltaTimeSec;
+		velocityY[i] += accelerationY[i] * deltaTimeSec;
+		positionX[i] += velocityX[i] * deltaTimeSec;
+		positionY[i] += velocityY[i] * deltaTimeSec;
+		age[i] += ageRate[i] * deltaTimeSec;
+	}
+#endif
+}
+
+void ParticlePool::RemoveExpired()
+{
+	size_t i = 0;
+	while (i < size) {
+		if (age[i] < 1.0f) {
+			++i;
+			continue;
+		}
+
+		--size;
+		positionX[i] = positionX[size];
+		positionY[i] = positionY[size];
+		velocityX[i] = velocityX[size];
+		velocityY[i] = velocityY[size];
+		accelerationX[i] = accelerationX[size];
+		accelerationY[i] = accelerationY[size];
+		age[i] = age[size];
+		ageRate[i] = ageRate[size];
+		startSize[i] = startSize[size];
+		endSize[i] = endSize[size];
+		startColor[i] = startColor[size];
+		endColor[i] = endColor[size];
+	}
+}
+
+size_t ParticlePool::AppendQuads(std::vector<SDL_Vertex>& vertices, const SDL_Rect& camera, const SDL_FRect& uvRect) const
+{
+	const float cameraX = static_cast<float>(camera.x);
+	const float cameraY = static_cast<float>(camera.y);
+	const float cameraW = static_cast<float>(camera.w);
+	const float cameraH = static_cast<float>(camera.h);
+	const float uvLeft = uvRect.x;
+	const float uvTop = uvRect.y;
+	const float uvRight = uvRect.x + uvRect.w;
+	const float uvBottom = uvRect.y + uvRect.h;
+
+	const size_t firstVertex = vertices.size();
+	vertices.resize(firstVertex + size * 4);
+	SDL_Vertex* vertex = vertices.data() + firstVertex;
+
+	for (size_t i = 0; i < size; ++i) {
+		const float t = age[i];
+		const float halfSize = 0.5f * (startSize[i] + (endSize[i] - startSize[i]) * t);
+		const float x = positionX[i] - cameraX;
+		const float y = positionY[i] - cameraY;
+
+		const bool isOutOfCameraView = (x + halfSize < 0.0f) || (x - halfSize > cameraW) || (y + halfSize < 0.0f) || (y - halfSize > cameraH);
+		if (isOutOfCameraView || halfSize <= 0.0f) {
+			continue;
+		}
+
+		const SDL_Color& from = startColor[i];
+		const SDL_Color& to = endColor[i];
+		const SDL_Color color = {
+			LerpChannel(from.r, to.r, t),
+			LerpChannel(from.g, to.g, t),
+			LerpChannel(from.b, to.b, t),
+			LerpChannel(from.a, to.a, t)
+		};
+
+		vertex[0] = { { x - halfSize, y - halfSize }, color, { uvLeft, uvTop } };
+		vertex[1] = { { x + halfSize, y - halfSize }, color, { uvRight, uvTop } };
+		vertex[2] = { { x + halfSize, y + halfSize }, color, { uvRight, uvBottom } };
+		vertex[3] = { { x - halfSize, y + halfSize }, color, { uvLeft, uvBottom } };
+		vertex += 4;
+	}
+
+	const size_t numQuads = static_cast<size_t>(vertex - (vertices.data() + firstVertex)) / 4;
+	vertices.resize(firstVertex + numQuads * 4);
+	return numQuads;
+}
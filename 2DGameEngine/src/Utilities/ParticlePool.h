@@ -0,0 +1,82 @@
+#pragma once
+
+#include <SDL.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_POOL_SSE
+#include <emmintrin.h>
+#endif
+
+// Particles updated by one SIMD step, the arrays are padded to a multiple of it.
+const size_t PARTICLE_POOL_WIDTH = 4;
+
+struct ParticleSpawn
+{
+	glm::vec2 position;
+	glm::vec2 velocity;
+	glm::vec2 acceleration;
+	float lifetimeS;
+	float startSize;
+	float endSize;
+	SDL_Color startColor;
+	SDL_Color endColor;
+};
+
+/**
+ * @brief Particles stored as one array per attribute, outside the ECS.
+ *
+ * Update integrates all particles with SIMD, then removes the expired ones by
+ * moving the last particle into their slot, so the live particles stay packed at
+ * the front and their order is not stable. Uses SSE when the build enables it,
+ * else plain loops.
+ */
+class ParticlePool
+{
+public:
+	ParticlePool(const size_t maxSize);
+
+	void Clear();
+
+	/**
+	 * @return @c false if the pool is full, the particle is dropped.
+	 */
+	bool Spawn(const ParticleSpawn& spawn);
+
+	void Update(const float deltaTimeSec);
+
+	/**
+	 * @brief Appends a quad of four vertices for every particle in camera view, sized and colored by its age.
+	 * @param uvRect Texture coordinates of the particle image, in any unit, e.g. pixels to be normalized later.
+	 * @return Number of quads appended.
+	 */
+	size_t AppendQuads(std::vector<SDL_Vertex>& vertices, const SDL_Rect& camera, const SDL_FRect& uvRect) const;
+
+	inline size_t GetSize() const { return size; }
+	inline size_t GetMaxSize() const { return maxSize; }
+
+private:
+	void Integrate(const float deltaTimeSec);
+	void RemoveExpired();
+
+private:
+	size_t size;
+	size_t maxSize;
+
+	std::vector<float> positionX;
+	std::vector<float> positionY;
+	std::vector<float> velocityX;
+	std::vector<float> velocityY;
+	std::vector<float> accelerationX;
+	std::vector<float> accelerationY;
+
+	// Age as a fraction of the lifetime, the particle expires at 1. Grows by ageRate per second.
+	std::vector<float> age;
+	std::vector<float> ageRate;
+
+	std::vector<float> startSize;
+	std::vector<float> endSize;
+	std::vector<SDL_Color> startColor;
+	std::vector<SDL_Color> endColor;
+};
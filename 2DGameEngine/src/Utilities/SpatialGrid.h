@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include <cstdint>
+
+/**
+ * @brief Sparse uniform grid of values with bounds, for area queries over things that rarely move.
+ *
+ * A value is stored only in the cell of its min corner. Queries widen the area by
+ * the largest inserted size instead, so every value is visited at most once.
+ * Queries may return values near the area that do not overlap it.
+ */
+template<typename T>
+class SpatialGrid
+{
+public:
+	using CellKey = uint64_t;
+
+	SpatialGrid(const float cellSize = 256.0f);
+
+	/**
+	 * @return Cell of the value, pass it to Remove.
+	 */
+	CellKey Insert(const T& value, const Aabb& bounds);
+	void Remove(const T& value, const CellKey cellKey);
+	void Clear();
+
+	/**
+	 * @brief Calls callback(value) for every value that may overlap the area.
+	 */
+	template<typename TCallback>
+	void Query(const Aabb& area, TCallback&& callback) const;
+
+private:
+	inline int GetCellCoordinate(const float position) const;
+	static inline CellKey GetCellKey(const int cellX, const int cellY);
+
+private:
+	float cellSize;
+	glm::vec2 maxValueSize;
+	std::unordered_map<CellKey, std::vector<T>> cells;
+};
+
+
+template<typename T>
+inline SpatialGrid<T>::SpatialGrid(const float cellSize)
+	: cellSize(cellSize)
+	, maxValueSize(0.0f)
+{
+	assert(cellSize > 0.0f);
+}
+
+template<typename T>
+inline typename SpatialGrid<T>::CellKey SpatialGrid<T>::Insert(const T& value, const Aabb& bounds)
+{
+	maxValueSize = glm::max(maxValueSize, glm::vec2(bounds.GetWidth(), bounds.GetHeight()));
+
+	const CellKey cellKey = GetCellKey(GetCellCoordinate(bounds.min.x), GetCellCoordinate(bounds.min.y));
+	cells[cellKey].push_back(value);
+	return cellKey;
+}
+
+template<typename T>
+inline void SpatialGrid<T>::Remove(const T& value, const CellKey cellKey)
+{
+	auto cellIt = cells.find(cellKey);
+	if (cellIt == cells.end()) {
+		return;
+	}
+
+	std::vector<T>& values = cellIt->second;
+	values.erase(std::remove(values.begin(), values.end(), value), values.end());
+	if (values.empty()) {
+		cells.erase(cellIt);
+	}
+}
+
+template<typename T>
+inline void SpatialGrid<T>::Clear()
+{
+	cells.clear();
+	maxValueSize = glm::vec2(0.0f);
+}
+
+template<typename T>
+template<typename TCallback>
+inline void SpatialGrid<T>::Query(const Aabb& area, TCallback&& callback) const
+{
+	if (cells.empty()) {
+		return;
+	}
+
+	// Values starting up to their size before the area can still reach into it.
+	const int minCellX = GetCellCoordinate(area.min.x - maxValueSize.x);
+	const int minCellY = GetCellCoordinate(area.min.y - maxValueSize.y);
+	const int maxCellX = GetCellCoordinate(area.max.x);
+	const int maxCellY = GetCellCoordinate(area.max.y);
+
+	for (int cellY = minCellY; cellY <= maxCellY; ++cellY) {
+		for (int cellX = minCellX; cellX <= maxCellX; ++cellX) {
+			auto cellIt = cells.find(GetCellKey(cellX, cellY));
+			if (cellIt == cells.end()) {
+				continue;
+			}
+
+			for (const T& value : cellIt->second) {
+				callback(value);
+			}
+		}
+	}
+}
+
+template<typename T>
+inline int SpatialGrid<T>::GetCellCoordinate(const float position) const
+{
+	return static_cast<int>(std::floor(position / cellSize));
+}
+
+template<typename T>
+inline typename SpatialGrid<T>::CellKey SpatialGrid<T>::GetCellKey(const int cellX, const int cellY)
+{
+	return (static_cast<CellKey>(static_cast<uint32_t>(cellX)) << 32) | static_cast<uint32_t>(cellY);
+}
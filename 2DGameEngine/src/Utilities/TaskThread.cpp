@@ -0,0 +1,74 @@
+#include "TaskThread.h"
+
+#include <assert.h>
+#include <utility>
+
+TaskThread::TaskThread()
+	: isBusy(false)
+	, isStopping(false)
+{
+}
+
+TaskThread::~TaskThread()
+{
+	if (!thread.joinable()) {
+		return;
+	}
+
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+
+	wakeCondition.notify_one();
+	thread.join();
+}
+
+void TaskThread::Start(std::function<void()> task)
+{
+	if (!thread.joinable()) {
+		thread = std::thread(&TaskThread::ThreadLoop, this);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		assert(!isBusy && "Wait() was not called for the previous task");
+		currentTask = std::move(task);
+		isBusy = true;
+	}
+
+	wakeCondition.notify_one();
+}
+
+void TaskThread::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this]() { return !isBusy; });
+}
+
+void TaskThread::ThreadLoop()
+{
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wakeCondition.wait(lock, [this]() { return isStopping || isBusy; });
+			if (isStopping) {
+				return;
+			}
+
+			task = std::move(currentTask);
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			isBusy = false;
+		}
+
+		doneCondition.notify_all();
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * @brief One thread that runs a single task at a time, in the background of the caller.
+ *
+ * Start hands over the task and returns at once, Wait blocks until it is done.
+ * The thread is created on the first Start, so unused instances cost nothing.
+ */
+class TaskThread
+{
+public:
+	TaskThread();
+	~TaskThread();
+
+	TaskThread(const TaskThread&) = delete;
+	TaskThread& operator=(const TaskThread&) = delete;
+
+	/**
+	 * @brief Runs the task on the thread. The previous task must be finished, see Wait.
+	 */
+	void Start(std::function<void()> task);
+	void Wait();
+
+private:
+	void ThreadLoop();
+
+private:
+	std::thread thread;
+
+	std::mutex mutex;
+	std::condition_variable wakeCondition;
+	std::condition_variable doneCondition;
+
+	std::function<void()> currentTask;
+	bool isBusy;
+	bool isStopping;
+};
@@ -0,0 +1,141 @@
+#include "TileCollisionGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+TileCollisionGrid::TileCollisionGrid()
+	: numColumns(0)
+	, numRows(0)
+	, cellSize(0.0f)
+{
+}
+
+/**
+ * @param tileMapIndices Tile index per cell, indexed as [row][column]. Negative indices are empty cells.
+ * @param solidTileIndices Tile indices of the tile texture that are solid.
+ * @param cellSize Size of a cell in world units, i.e. with the map scale applied.
+ */
+void TileCollisionGrid::Build(const std::vector<std::vector<int>>& tileMapIndices, const std::vector<int>& solidTileIndices, const float cellSize)
+{
+	assert(cellSize > 0.0f);
+
+	Clear();
+	if (solidTileIndices.empty() || tileMapIndices.empty()) {
+		return;
+	}
+
+	const int maxTileIndex = *std::max_element(solidTileIndices.begin(), solidTileIndices.end());
+	std::vector<uint8_t> isSolidTile(static_cast<size_t>(std::max(maxTileIndex, 0)) + 1, 0);
+	for (const int tileIndex : solidTileIndices) {
+		if (tileIndex >= 0) {
+			isSolidTile[tileIndex] = 1;
+		}
+	}
+
+	numRows = static_cast<int>(tileMapIndices.size());
+	numColumns = 0;
+	for (const std::vector<int>& row : tileMapIndices) {
+		numColumns = std::max(numColumns, static_cast<int>(row.size()));
+	}
+
+	this->cellSize = cellSize;
+	solidCells.assign(static_cast<size_t>(numRows) * numColumns, 0);
+
+	for (int row = 0; row < numRows; ++row) {
+		for (int column = 0; column < static_cast<int>(tileMapIndices[row].size()); ++column) {
+			const int tileIndex = tileMapIndices[row][column];
+			if (tileIndex >= 0 && tileIndex < static_cast<int>(isSolidTile.size())) {
+				solidCells[static_cast<size_t>(row) * numColumns + column] = isSolidTile[tileIndex];
+			}
+		}
+	}
+}
+
+void TileCollisionGrid::Clear()
+{
+	solidCells.clear();
+	numColumns = 0;
+	numRows = 0;
+}
+
+Aabb TileCollisionGrid::GetCellAabb(const int column, const int row) const
+{
+	const glm::vec2 cellMin(column * cellSize, row * cellSize);
+	return Aabb(cellMin, cellMin + glm::vec2(cellSize));
+}
+
+bool TileCollisionGrid::Overlaps(const Aabb& aabb) const
+{
+	bool overlaps = false;
+	ForEachSolidCell(aabb, [&overlaps](const int, const int) {
+		overlaps = true;
+		return false;
+	});
+
+	return overlaps;
+}
+
+/**
+ * @brief Translation that moves the box out of the solid cells it overlaps.
+ *
+ * The cell with the largest overlap is resolved first, along its axis of least overlap, and the cells are
+ * tested again with the moved box. Neighbouring cells of the same wall therefore do not push the box twice
+ * and the box does not snag on the seams between them.
+ */
+glm::vec2 TileCollisionGrid::GetPenetration(const Aabb& aabb) const
+{
+	const int MAX_ITERATIONS = 4;
+
+	Aabb box = aabb;
+	for (int i = 0; i < MAX_ITERATIONS; ++i) {
+		float maxOverlapArea = 0.0f;
+		glm::vec2 push(0.0f);
+
+		ForEachSolidCell(box, [&](const int column, const int row) {
+			const Aabb cell = GetCellAabb(column, row);
+			const float overlapX = std::min(box.max.x, cell.max.x) - std::max(box.min.x, cell.min.x);
+			const float overlapY = std::min(box.max.y, cell.max.y) - std::max(box.min.y, cell.min.y);
+			if (overlapX <= 0.0f || overlapY <= 0.0f || overlapX * overlapY <= maxOverlapArea) {
+				return true;
+			}
+
+			maxOverlapArea = overlapX * overlapY;
+			push = glm::vec2(0.0f);
+			if (overlapX < overlapY) {
+				push.x = (box.min.x + box.max.x < cell.min.x + cell.max.x) ? -overlapX : overlapX;
+			}
+			else {
+				push.y = (box.min.y + box.max.y < cell.min.y + cell.max.y) ? -overlapY : overlapY;
+			}
+			return true;
+		});
+
+		if (maxOverlapArea == 0.0f) {
+			break;
+		}
+
+		box.min += push;
+		box.max += push;
+	}
+
+	return box.min - aabb.min;
+}
+
+/**
+ * @brief Cells covered by the box, clamped to the map.
+ * @return @c false if the box is outside of the map.
+ */
+bool TileCollisionGrid::GetCellRange(const Aabb& aabb, int& outMinColumn, int& outMinRow, int& outMaxColumn, int& outMaxRow) const
+{
+	if (IsEmpty()) {
+		return false;
+	}
+
+	// Max is exclusive, a box ending exactly on a cell border does not cover the next cell.
+	outMinColumn = std::max(static_cast<int>(std::floor(aabb.min.x / cellSize)), 0);
+	outMinRow = std::max(static_cast<int>(std::floor(aabb.min.y / cellSize)), 0);
+	outMaxColumn = std::min(static_cast<int>(std::ceil(aabb.max.x / cellSize)) - 1, numColumns - 1);
+	outMaxRow = std::min(static_cast<int>(std::ceil(aabb.max.y / cellSize)) - 1, numRows - 1);
+
+	return (outMinColumn <= outMaxColumn) && (outMinRow <= outMaxRow);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Geometry.h"
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Solidity of the tilemap cells, used to collide against terrain without tile entities.
+ *
+ * Built from the tilemap indices and the set of tile indices that are solid.
+ * A box is tested by walking the cells it covers, so the cost depends on the
+ * size of the box and not on the size of the map.
+ */
+class TileCollisionGrid
+{
+public:
+	TileCollisionGrid();
+
+	void Build(const std::vector<std::vector<int>>& tileMapIndices, const std::vector<int>& solidTileIndices, const float cellSize);
+	void Clear();
+
+	inline bool IsEmpty() const { return solidCells.empty(); }
+	inline float GetCellSize() const { return cellSize; }
+	inline int GetNumColumns() const { return numColumns; }
+	inline int GetNumRows() const { return numRows; }
+
+	// Cells outside of the map are not solid.
+	inline bool IsSolid(const int column, const int row) const;
+	Aabb GetCellAabb(const int column, const int row) const;
+
+	bool Overlaps(const Aabb& aabb) const;
+	glm::vec2 GetPenetration(const Aabb& aabb) const;
+
+	/**
+	 * @brief Calls callback(column, row) for every solid cell the box covers.
+	 * Touching a cell only at its edge does not count. Return @c false from the callback to stop.
+	 */
+	template<typename TCallback>
+	void ForEachSolidCell(const Aabb& aabb, TCallback&& callback) const;
+
+private:
+	bool GetCellRange(const Aabb& aabb, int& outMinColumn, int& outMinRow, int& outMaxColumn, int& outMaxRow) const;
+
+private:
+	// Row major, one byte per cell.
+	std::vector<uint8_t> solidCells;
+	int numColumns;
+	int numRows;
+	float cellSize;
+};
+
+
+bool TileCollisionGrid::IsSolid(const int column, const int row) const
+{
+	if (column < 0 || row < 0 || column >= numColumns || row >= numRows) {
+		return false;
+	}
+
+	return solidCells[static_cast<size_t>(row) * numColumns + column] != 0;
+}
+
+template<typename TCallback>
+inline void TileCollisionGrid::ForEachSolidCell(const Aabb& aabb, TCallback&& callback) const
+{
+	int minColumn, minRow, maxColumn, maxRow;
+	if (!GetCellRange(aabb, minColumn, minRow, maxColumn, maxRow)) {
+		return;
+	}
+
+	for (int row = minRow; row <= maxRow; ++row) {
+		const uint8_t* rowCells = &solidCells[static_cast<size_t>(row) * numColumns];
+		for (int column = minColumn; column <= maxColumn; ++column) {
+			if (rowCells[column] && !callback(column, row)) {
+				return;
+			}
+		}
+	}
+}
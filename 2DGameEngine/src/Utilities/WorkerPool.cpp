@@ -0,0 +1,127 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(const unsigned numWorkers)
+	: currentTask(nullptr)
+	, numTasks(0)
+	, nextTaskIndex(0)
+	, numFinishedTasks(0)
+	, numActiveWorkers(0)
+	, batchId(0)
+	, isStopping(false)
+{
+	workers.reserve(numWorkers);
+	for (unsigned i = 0; i < numWorkers; ++i) {
+		workers.emplace_back(&WorkerPool::WorkerLoop, this);
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+
+	wakeCondition.notify_all();
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+void WorkerPool::Run(const size_t numTasksToRun, const std::function<void(size_t)>& task)
+{
+	if (numTasksToRun == 0) {
+		return;
+	}
+
+	if (workers.empty() || numTasksToRun == 1) {
+		for (size_t i = 0; i < numTasksToRun; ++i) {
+			task(i);
+		}
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		currentTask = &task;
+		numTasks = numTasksToRun;
+		nextTaskIndex = 0;
+		numFinishedTasks = 0;
+		++batchId;
+	}
+
+	wakeCondition.notify_all();
+	ExecuteTasks();
+
+	// Workers that joined the batch still hold the task, wait for them before it goes out of scope.
+	std::unique_lock<std::mutex> lock(mutex);
+	doneCondition.wait(lock, [this]() { return numFinishedTasks == numTasks && numActiveWorkers == 0; });
+	currentTask = nullptr;
+}
+
+/**
+ * @brief Leaves one hardware thread for the caller.
+ */
+unsigned WorkerPool::GetDefaultWorkerCount()
+{
+	const unsigned numHardwareThreads = std::thread::hardware_concurrency();
+	return (numHardwareThreads > 1) ? (numHardwareThreads - 1) : 0;
+}
+
+void WorkerPool::WorkerLoop()
+{
+	unsigned lastBatchId = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wakeCondition.wait(lock, [&]() { return isStopping || batchId != lastBatchId; });
+
+			if (isStopping) {
+				return;
+			}
+
+			lastBatchId = batchId;
+			if (!currentTask) {
+				// Woke up after the batch was already done.
+				continue;
+			}
+
+			++numActiveWorkers;
+		}
+
+		ExecuteTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--numActiveWorkers;
+		}
+
+		doneCondition.notify_one();
+	}
+}
+
+void WorkerPool::ExecuteTasks()
+{
+	size_t numExecutedTasks = 0;
+	for (size_t taskIndex = nextTaskIndex++; taskIndex < numTasks; taskIndex = nextTaskIndex++) {
+		(*currentTask)(taskIndex);
+		++numExecutedTasks;
+	}
+
+	if (numExecutedTasks == 0) {
+		return;
+	}
+
+	bool isBatchDone = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		numFinishedTasks += numExecutedTasks;
+		isBatchDone = (numFinishedTasks == numTasks);
+	}
+
+	if (isBatchDone) {
+		doneCondition.notify_one();
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief Fixed set of threads that run batches of independent tasks.
+ *
+ * The threads are created once and sleep between batches. The calling thread
+ * also works on the batch, so a pool with zero workers runs everything inline.
+ * Which thread runs which task is not defined; callers that need a stable result
+ * should write into per-task outputs and merge them in task order.
+ */
+class WorkerPool
+{
+public:
+	WorkerPool(const unsigned numWorkers = GetDefaultWorkerCount());
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/**
+	 * @brief Calls task(taskIndex) for every index in [0, numTasks) and blocks until all of them are done.
+	 */
+	void Run(const size_t numTasks, const std::function<void(size_t)>& task);
+
+	inline unsigned GetThreadCount() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+	static unsigned GetDefaultWorkerCount();
+
+private:
+	void WorkerLoop();
+	void ExecuteTasks();
+
+private:
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wakeCondition;
+	std::condition_variable doneCondition;
+
+	const std::function<void(size_t)>* currentTask;
+	size_t numTasks;
+	std::atomic<size_t> nextTaskIndex;
+	size_t numFinishedTasks;
+	unsigned numActiveWorkers;
+	unsigned batchId;
+	bool isStopping;
+};